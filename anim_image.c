@@ -0,0 +1,528 @@
+#include "anim_image.h"
+#include <graphics/image-file.h>
+#include <util/bmem.h>
+#include <util/dstr.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include <ctype.h>
+#include <string.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+// 常駐模式每次 render 最多上傳的格數，避免載入期間單幀卡頓
+#define ANIM_IMAGE_UPLOADS_PER_FRAME 4
+
+#define ANIM_IMAGE_NONE ((size_t)-1)
+
+enum anim_image_state {
+    ANIM_IMAGE_LOADING = 0,
+    ANIM_IMAGE_STATIC,
+    ANIM_IMAGE_GIF,
+    ANIM_IMAGE_RESIDENT,
+    ANIM_IMAGE_STREAMED,
+};
+
+// 串流模式的預先解碼槽
+struct anim_prefetch {
+    size_t index;    // 解碼中或已解碼的格（ANIM_IMAGE_NONE = 空）
+    uint8_t *pixels;
+    bool ready;      // false 表示正在解碼
+};
+
+struct anim_image {
+    char *path;
+    bool is_gif;
+    volatile long state;
+
+    // 圖片序列（載入執行緒設定後不再變動）
+    char **files;
+    size_t frame_count;
+    uint32_t width;
+    uint32_t height;
+    enum gs_color_format format;
+    size_t frame_bytes;
+
+    // 常駐模式
+    uint8_t **pixels;         // 已解碼、等待上傳的格（mutex）
+    size_t decoded;           // 載入執行緒已處理的格數（mutex）
+    gs_texture_t **textures;  // 圖形執行緒
+    size_t uploaded;
+    gs_texture_t *shown_texture;
+
+    // 串流模式
+    struct anim_prefetch prefetch[ANIM_IMAGE_PREFETCH]; // mutex
+    size_t prefetch_count;    // 實際使用的槽數：連同串流紋理不超過預算
+    gs_texture_t *stream_texture;
+    size_t stream_index;      // 串流紋理目前的格
+
+    // GIF
+    gs_image_file4_t gif;
+    bool gif_loaded;
+    bool gif_texture;
+    bool gif_dirty;
+
+    // 播放（圖形執行緒；frame 另受 mutex 保護，載入執行緒依此決定預先解碼的位置）
+    uint64_t last_tick_ns;
+    uint64_t play_ns;
+    size_t frame;
+    bool frame_counted;       // 這一格已計入命中或未命中
+
+    uint64_t hits;
+    uint64_t misses;
+
+    pthread_mutex_t mutex;
+    os_sem_t *wake;
+    pthread_t thread;
+    bool thread_created;
+    volatile bool stopping;
+};
+
+static bool anim_image_has_extension(const char *path, const char *ext)
+{
+    const char *dot = strrchr(path, '.');
+    return dot && astrcmpi(dot, ext) == 0;
+}
+
+// 找出檔名結尾的數字：name_0012.png → prefix "name_"、數字 12、寬度 4、suffix ".png"
+static bool anim_image_parse_sequence(const char *path, struct dstr *prefix, struct dstr *suffix, long *number,
+                                      int *digits)
+{
+    const char *base = path;
+    for (const char *p = path; *p; ++p) {
+        if (*p == '/' || *p == '\\') base = p + 1;
+    }
+    const char *dot = strrchr(base, '.');
+    if (!dot) dot = base + strlen(base);
+
+    const char *start = dot;
+    while (start > base && isdigit((unsigned char)start[-1])) --start;
+    if (start == dot || dot - start > 9) return false;
+
+    dstr_ncopy(prefix, path, (size_t)(start - path));
+    dstr_copy(suffix, dot);
+    *number = strtol(start, NULL, 10);
+    *digits = (int)(dot - start);
+    return true;
+}
+
+static char *anim_image_sequence_file(const struct dstr *prefix, const struct dstr *suffix, long number, int digits)
+{
+    struct dstr name = {0};
+    dstr_printf(&name, "%s%0*ld%s", prefix->array, digits, number, suffix->array ? suffix->array : "");
+    return name.array;
+}
+
+// 從選取的檔案往前後找連號的檔案
+static void anim_image_scan_sequence(struct anim_image *a)
+{
+    struct dstr prefix = {0}, suffix = {0};
+    long number;
+    int digits;
+    if (!anim_image_parse_sequence(a->path, &prefix, &suffix, &number, &digits)) return;
+
+    long first = number;
+    while (first > 0 && number - first < ANIM_IMAGE_MAX_FRAMES) {
+        char *name = anim_image_sequence_file(&prefix, &suffix, first - 1, digits);
+        bool exists = os_file_exists(name);
+        bfree(name);
+        if (!exists) break;
+        --first;
+    }
+
+    size_t capacity = 0;
+    for (long n = first; a->frame_count < ANIM_IMAGE_MAX_FRAMES; ++n) {
+        char *name = anim_image_sequence_file(&prefix, &suffix, n, digits);
+        if (!os_file_exists(name)) {
+            bfree(name);
+            break;
+        }
+        if (a->frame_count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            a->files = brealloc(a->files, capacity * sizeof(char *));
+        }
+        a->files[a->frame_count++] = name;
+    }
+    dstr_free(&prefix);
+    dstr_free(&suffix);
+}
+
+// 解碼一格；尺寸或格式與第一格不同時視為失敗
+static uint8_t *anim_image_decode(struct anim_image *a, size_t index)
+{
+    enum gs_color_format format = GS_UNKNOWN;
+    uint32_t cx = 0, cy = 0;
+    uint8_t *data = gs_create_texture_file_data(a->files[index], &format, &cx, &cy);
+    if (data && (cx != a->width || cy != a->height || format != a->format)) {
+        blog(LOG_WARNING, BLOG_PREFIX "圖片序列的尺寸或格式不一致，略過: %s", a->files[index]);
+        bfree(data);
+        data = NULL;
+    }
+    return data;
+}
+
+static void anim_image_load_gif(struct anim_image *a)
+{
+    gs_image_file4_init(&a->gif, a->path, GS_IMAGE_ALPHA_STRAIGHT);
+    a->gif_loaded = true;
+
+    const gs_image_file_t *image = &a->gif.image3.image2.image;
+    long state = ANIM_IMAGE_STATIC;
+    if (image->loaded && image->is_animated_gif) {
+        if (a->gif.image3.image2.mem_usage <= ANIM_IMAGE_BUDGET) {
+            state = ANIM_IMAGE_GIF;
+        } else {
+            blog(LOG_WARNING, BLOG_PREFIX "GIF 解碼後需要 %.1f MB，超過 %.1f MB 的上限，只顯示第一格: %s",
+                 (double)a->gif.image3.image2.mem_usage / (1024.0 * 1024.0),
+                 (double)ANIM_IMAGE_BUDGET / (1024.0 * 1024.0), a->path);
+        }
+    }
+    // GIF 的所有格在 gs_image_file4_init 內一次解碼完畢，只能在解碼後檢查；
+    // 停止中時不進入圖形上下文，解碼結果交給 anim_image_destroy 釋放
+    if (os_atomic_load_bool(&a->stopping)) return;
+    if (state == ANIM_IMAGE_STATIC) {
+        // 靜態圖片由紋理快取負責，這裡的解碼結果立即釋放
+        obs_enter_graphics();
+        gs_image_file4_free(&a->gif);
+        obs_leave_graphics();
+        a->gif_loaded = false;
+    }
+    os_atomic_set_long(&a->state, state);
+}
+
+// 串流模式：依目前的格填滿預先解碼槽
+static void anim_image_prefetch(struct anim_image *a)
+{
+    for (size_t ahead = 0; ahead < a->prefetch_count; ++ahead) {
+        if (os_atomic_load_bool(&a->stopping)) return;
+
+        pthread_mutex_lock(&a->mutex);
+        size_t want = (a->frame + ahead) % a->frame_count;
+        int slot = -1;
+        bool have = false;
+        for (size_t i = 0; i < a->prefetch_count; ++i) {
+            if (a->prefetch[i].index == want) have = true;
+        }
+        for (size_t i = 0; !have && slot < 0 && i < a->prefetch_count; ++i) {
+            size_t index = a->prefetch[i].index;
+            // 不在接下來要播放的範圍內的槽可以重用
+            if (index == ANIM_IMAGE_NONE ||
+                (index + a->frame_count - a->frame) % a->frame_count >= a->prefetch_count) {
+                slot = (int)i;
+            }
+        }
+        uint8_t *old = NULL;
+        if (slot >= 0) {
+            old = a->prefetch[slot].pixels;
+            a->prefetch[slot].pixels = NULL;
+            a->prefetch[slot].index = want;
+            a->prefetch[slot].ready = false;
+        }
+        pthread_mutex_unlock(&a->mutex);
+        bfree(old);
+        if (slot < 0) continue;
+
+        uint8_t *data = anim_image_decode(a, want);
+        pthread_mutex_lock(&a->mutex);
+        if (a->prefetch[slot].index == want && !a->prefetch[slot].ready) {
+            // 解碼失敗的格以空槽標記為已就緒，播放時沿用上一格
+            a->prefetch[slot].pixels = data;
+            a->prefetch[slot].ready = true;
+            data = NULL;
+        }
+        pthread_mutex_unlock(&a->mutex);
+        bfree(data);
+    }
+}
+
+static void anim_image_load_sequence(struct anim_image *a)
+{
+    anim_image_scan_sequence(a);
+    if (a->frame_count < 2) {
+        os_atomic_set_long(&a->state, ANIM_IMAGE_STATIC);
+        return;
+    }
+
+    uint8_t *first = gs_create_texture_file_data(a->files[0], &a->format, &a->width, &a->height);
+    if (!first) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法載入圖片序列: %s", a->files[0]);
+        os_atomic_set_long(&a->state, ANIM_IMAGE_STATIC);
+        return;
+    }
+    a->frame_bytes = (size_t)a->width * a->height * 4;
+
+    if (a->frame_bytes * a->frame_count <= ANIM_IMAGE_BUDGET) {
+        // 常駐：依序解碼所有格，render 逐步上傳
+        a->pixels = bzalloc(a->frame_count * sizeof(uint8_t *));
+        a->textures = bzalloc(a->frame_count * sizeof(gs_texture_t *));
+        a->pixels[0] = first;
+        a->decoded = 1;
+        os_atomic_set_long(&a->state, ANIM_IMAGE_RESIDENT);
+
+        for (size_t i = 1; i < a->frame_count && !os_atomic_load_bool(&a->stopping); ++i) {
+            uint8_t *data = anim_image_decode(a, i);
+            pthread_mutex_lock(&a->mutex);
+            a->pixels[i] = data;
+            a->decoded = i + 1;
+            pthread_mutex_unlock(&a->mutex);
+        }
+        return;
+    }
+
+    // 串流：只保留接下來幾格
+    blog(LOG_INFO, BLOG_PREFIX "圖片序列共 %zu 格（%.1f MB）超過上限，改為串流播放", a->frame_count,
+         (double)(a->frame_bytes * a->frame_count) / (1024.0 * 1024.0));
+    size_t fit = (size_t)(ANIM_IMAGE_BUDGET / a->frame_bytes);
+    a->prefetch_count = fit > ANIM_IMAGE_PREFETCH + 1 ? ANIM_IMAGE_PREFETCH : (fit > 2 ? fit - 1 : 1);
+    a->prefetch[0].index = 0;
+    a->prefetch[0].pixels = first;
+    a->prefetch[0].ready = true;
+    os_atomic_set_long(&a->state, ANIM_IMAGE_STREAMED);
+
+    while (!os_atomic_load_bool(&a->stopping)) {
+        anim_image_prefetch(a);
+        os_sem_wait(a->wake);
+    }
+}
+
+static void *anim_image_thread(void *param)
+{
+    struct anim_image *a = param;
+    os_set_thread_name("dr_cursor_tracker: animation loader");
+    if (a->is_gif) {
+        anim_image_load_gif(a);
+    } else {
+        anim_image_load_sequence(a);
+    }
+    return NULL;
+}
+
+struct anim_image *anim_image_create(const char *path, bool play_sequence)
+{
+    if (!path || !*path) return NULL;
+
+    bool is_gif = anim_image_has_extension(path, ".gif");
+    if (!is_gif) {
+        // 檔名剛好以數字結尾的一般圖片不應自動變成動畫，需由設定明確開啟
+        if (!play_sequence) return NULL;
+
+        struct dstr prefix = {0}, suffix = {0};
+        long number;
+        int digits;
+        bool sequence = anim_image_parse_sequence(path, &prefix, &suffix, &number, &digits);
+        dstr_free(&prefix);
+        dstr_free(&suffix);
+        if (!sequence) return NULL;
+    }
+
+    struct anim_image *a = bzalloc(sizeof(struct anim_image));
+    a->path = bstrdup(path);
+    a->is_gif = is_gif;
+    a->stream_index = ANIM_IMAGE_NONE;
+    for (int i = 0; i < ANIM_IMAGE_PREFETCH; ++i) a->prefetch[i].index = ANIM_IMAGE_NONE;
+
+    if (pthread_mutex_init(&a->mutex, NULL) != 0) {
+        bfree(a->path);
+        bfree(a);
+        return NULL;
+    }
+    if (os_sem_init(&a->wake, 0) != 0 || pthread_create(&a->thread, NULL, anim_image_thread, a) != 0) {
+        // 沒有載入執行緒時只顯示靜態圖片
+        blog(LOG_WARNING, BLOG_PREFIX "無法建立動畫載入執行緒，只顯示第一格");
+        if (a->wake) os_sem_destroy(a->wake);
+        pthread_mutex_destroy(&a->mutex);
+        bfree(a->path);
+        bfree(a);
+        return NULL;
+    }
+    a->thread_created = true;
+    return a;
+}
+
+void anim_image_destroy(struct anim_image *anim)
+{
+    if (!anim) return;
+
+    if (anim->thread_created) {
+        os_atomic_store_bool(&anim->stopping, true);
+        os_sem_post(anim->wake);
+        pthread_join(anim->thread, NULL);
+    }
+
+    // 載入執行緒結束後才進入圖形上下文，只用來釋放紋理
+    obs_enter_graphics();
+    if (anim->gif_loaded) gs_image_file4_free(&anim->gif);
+    if (anim->textures) {
+        for (size_t i = 0; i < anim->frame_count; ++i) gs_texture_destroy(anim->textures[i]);
+    }
+    gs_texture_destroy(anim->stream_texture);
+    obs_leave_graphics();
+
+    for (size_t i = 0; i < anim->frame_count; ++i) {
+        if (anim->pixels) bfree(anim->pixels[i]);
+        bfree(anim->files[i]);
+    }
+    for (int i = 0; i < ANIM_IMAGE_PREFETCH; ++i) bfree(anim->prefetch[i].pixels);
+    bfree(anim->textures);
+    bfree(anim->pixels);
+    bfree(anim->files);
+
+    os_sem_destroy(anim->wake);
+    pthread_mutex_destroy(&anim->mutex);
+    bfree(anim->path);
+    bfree(anim);
+}
+
+bool anim_image_is_static(struct anim_image *anim)
+{
+    return os_atomic_load_long(&anim->state) == ANIM_IMAGE_STATIC;
+}
+
+void anim_image_tick(struct anim_image *anim, uint64_t now_ns, float sequence_fps)
+{
+    uint64_t elapsed = anim->last_tick_ns ? now_ns - anim->last_tick_ns : 0;
+    anim->last_tick_ns = now_ns;
+
+    long state = os_atomic_load_long(&anim->state);
+    if (state == ANIM_IMAGE_GIF) {
+        if (gs_image_file4_tick(&anim->gif, elapsed)) anim->gif_dirty = true;
+        return;
+    }
+    if (state != ANIM_IMAGE_RESIDENT && state != ANIM_IMAGE_STREAMED) return;
+
+    // 以累積時間換算目前的格，幀率變更時不需重設
+    uint64_t frame_ns = (uint64_t)(1000000000.0 / (sequence_fps > 1.0f ? sequence_fps : 1.0f));
+    anim->play_ns += elapsed;
+    size_t frame = (size_t)((anim->play_ns / frame_ns) % anim->frame_count);
+    if (frame == anim->frame) return;
+
+    pthread_mutex_lock(&anim->mutex);
+    anim->frame = frame;
+    pthread_mutex_unlock(&anim->mutex);
+    anim->frame_counted = false;
+    if (state == ANIM_IMAGE_STREAMED) os_sem_post(anim->wake);
+}
+
+static gs_texture_t *anim_image_resident_texture(struct anim_image *a)
+{
+    pthread_mutex_lock(&a->mutex);
+    for (int n = 0; a->uploaded < a->decoded && n < ANIM_IMAGE_UPLOADS_PER_FRAME; ++n, ++a->uploaded) {
+        uint8_t *pixels = a->pixels[a->uploaded];
+        if (!pixels) continue;
+        const uint8_t *data = pixels;
+        a->textures[a->uploaded] = gs_texture_create(a->width, a->height, a->format, 1, &data, 0);
+        a->pixels[a->uploaded] = NULL;
+        bfree(pixels);
+    }
+    pthread_mutex_unlock(&a->mutex);
+
+    gs_texture_t *texture = a->textures[a->frame];
+    if (texture) {
+        a->shown_texture = texture;
+        if (!a->frame_counted) a->hits++;
+        a->frame_counted = true;
+    } else if (a->frame >= a->uploaded && !a->frame_counted) {
+        // 這一格還沒解碼或上傳完成：沿用上一格並計入未命中
+        a->misses++;
+        a->frame_counted = true;
+    }
+    // 已處理但沒有紋理的格（frame < uploaded）是解碼失敗，同樣沿用上一格，但不計入未命中
+    return a->shown_texture;
+}
+
+static gs_texture_t *anim_image_streamed_texture(struct anim_image *a)
+{
+    if (!a->stream_texture) {
+        a->stream_texture = gs_texture_create(a->width, a->height, a->format, 1, NULL, GS_DYNAMIC);
+        if (!a->stream_texture) return NULL;
+    }
+    if (a->stream_index == a->frame) return a->stream_texture;
+
+    uint8_t *consumed = NULL;
+    bool found = false;
+    pthread_mutex_lock(&a->mutex);
+    for (size_t i = 0; i < a->prefetch_count; ++i) {
+        struct anim_prefetch *slot = &a->prefetch[i];
+        if (slot->index != a->frame || !slot->ready) continue;
+        if (slot->pixels) {
+            gs_texture_set_image(a->stream_texture, slot->pixels, a->width * 4, false);
+            a->stream_index = a->frame;
+        }
+        consumed = slot->pixels;
+        slot->pixels = NULL;
+        slot->index = ANIM_IMAGE_NONE;
+        found = true;
+        break;
+    }
+    pthread_mutex_unlock(&a->mutex);
+
+    if (found) {
+        bfree(consumed);
+        os_sem_post(a->wake); // 空出的槽可以解碼下一格
+    }
+    if (!a->frame_counted) {
+        if (found) {
+            a->hits++;
+        } else {
+            a->misses++;
+        }
+        a->frame_counted = true;
+    }
+    return a->stream_index != ANIM_IMAGE_NONE ? a->stream_texture : NULL;
+}
+
+gs_texture_t *anim_image_get_texture(struct anim_image *anim)
+{
+    switch (os_atomic_load_long(&anim->state)) {
+    case ANIM_IMAGE_GIF:
+        if (!anim->gif_texture) {
+            gs_image_file4_init_texture(&anim->gif);
+            anim->gif_texture = true;
+        } else if (anim->gif_dirty) {
+            gs_image_file4_update_texture(&anim->gif);
+        }
+        anim->gif_dirty = false;
+        return anim->gif.image3.image2.image.texture;
+    case ANIM_IMAGE_RESIDENT:
+        return anim_image_resident_texture(anim);
+    case ANIM_IMAGE_STREAMED:
+        return anim_image_streamed_texture(anim);
+    default:
+        return NULL;
+    }
+}
+
+void anim_image_get_stats(struct anim_image *anim, struct anim_image_stats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->budget = ANIM_IMAGE_BUDGET;
+    stats->hits = anim->hits;
+    stats->misses = anim->misses;
+
+    long state = os_atomic_load_long(&anim->state);
+    if (state == ANIM_IMAGE_GIF) {
+        const gs_image_file_t *image = &anim->gif.image3.image2.image;
+        size_t frame_bytes = (size_t)image->cx * image->cy * 4;
+        stats->bytes = (size_t)anim->gif.image3.image2.mem_usage;
+        stats->frame_count = frame_bytes ? stats->bytes / frame_bytes : 0;
+        return;
+    }
+    if (state != ANIM_IMAGE_RESIDENT && state != ANIM_IMAGE_STREAMED) return;
+
+    stats->frame_count = anim->frame_count;
+    stats->streamed = state == ANIM_IMAGE_STREAMED;
+    size_t frames = 0;
+    pthread_mutex_lock(&anim->mutex);
+    if (stats->streamed) {
+        for (size_t i = 0; i < anim->prefetch_count; ++i) {
+            if (anim->prefetch[i].pixels) frames++;
+        }
+        if (anim->stream_texture) frames++;
+    } else {
+        // 等待上傳的像素與已上傳的紋理各佔一格的大小
+        for (size_t i = 0; i < anim->decoded; ++i) {
+            if (anim->pixels[i] || anim->textures[i]) frames++;
+        }
+    }
+    pthread_mutex_unlock(&anim->mutex);
+    stats->bytes = frames * anim->frame_bytes;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <obs-module.h>
+
+// 動態自訂準心圖片
+// 支援兩種來源：
+//   GIF：以 libobs 的 gs_image_file4 解碼並依檔案內的每格時間播放（與 OBS 內建圖片來源相同）；
+//        解碼後所有格都會留在記憶體中，總大小超過 ANIM_IMAGE_BUDGET 時只顯示第一格。
+//   圖片序列：允許時（play_sequence），選取 name_0001.png 這類以數字結尾的檔案會依固定幀率播放連號的相鄰檔案。
+//        所有格能放進預算時全部上傳為常駐紋理；否則改為串流，背景執行緒預先解碼接下來的
+//        ANIM_IMAGE_PREFETCH 格（單格過大時減少，至少一格），播放時上傳到同一張動態紋理。
+// 解碼在每個動畫自己的背景執行緒上進行；tick 與 render 都在圖形執行緒上呼叫。
+
+#define ANIM_IMAGE_BUDGET (64ULL * 1024 * 1024) // 每個動畫解碼後佔用的記憶體上限（位元組）
+#define ANIM_IMAGE_PREFETCH 4                   // 串流模式最多預先解碼的格數
+#define ANIM_IMAGE_MAX_FRAMES 4096              // 圖片序列的格數上限
+
+struct anim_image;
+
+struct anim_image_stats {
+    size_t frame_count;
+    size_t bytes;     // 目前佔用的解碼資料與紋理大小
+    size_t budget;
+    bool streamed;
+    uint64_t hits;    // 需要顯示時已解碼好的格數
+    uint64_t misses;  // 尚未解碼、繼續顯示上一格的次數
+};
+
+// 路徑看起來可能是動畫時才建立（.gif，或 play_sequence 時數字結尾的檔名），否則回傳 NULL
+struct anim_image *anim_image_create(const char *path, bool play_sequence);
+// 不可在圖形上下文中呼叫：先等待載入執行緒結束（GIF 載入時會進入圖形上下文），再自行進入以釋放紋理
+void anim_image_destroy(struct anim_image *anim);
+
+// 載入完成後確認不是動畫（單格 GIF、找不到連號檔案或超過預算的 GIF），呼叫端應改用靜態圖片
+bool anim_image_is_static(struct anim_image *anim);
+
+// 推進播放時間（tick）；sequence_fps 只用於圖片序列，GIF 使用檔案內的每格時間
+void anim_image_tick(struct anim_image *anim, uint64_t now_ns, float sequence_fps);
+// 上傳需要的格並回傳目前要繪製的紋理；尚無可用的格時回傳 NULL（render）
+gs_texture_t *anim_image_get_texture(struct anim_image *anim);
+
+void anim_image_get_stats(struct anim_image *anim, struct anim_image_stats *stats);
@@ -0,0 +1,279 @@
+#include "circle_raster.h"
+#include <util/bmem.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CIRCLE_RASTER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CR_SSE2_TARGET
+#define CR_AVX2_TARGET
+#else
+#define CR_SSE2_TARGET __attribute__((target("sse2")))
+#define CR_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#define CIRCLE_RASTER_PAD 8 // 列緩衝區補齊到最寬的向量（AVX2 = 8 個像素）
+
+// 單一圓環的常數（與原本逐像素版本的 smoothstep 參數相同）
+struct circle_raster_ctx {
+    float band_lo; // 寫入顏色的距離範圍
+    float band_hi;
+    float in_e0;   // 內緣 smoothstep(inner, inner + edge)
+    float in_w;
+    float out_e0;  // 外緣 smoothstep(outer - edge, outer)
+    float out_w;
+    uint8_t a;
+    uint32_t rgb;  // 記憶體順序 R, G, B（alpha 另外填入）
+};
+
+static inline float clampf(float x, float min_val, float max_val)
+{
+    if (x < min_val) return min_val;
+    if (x > max_val) return max_val;
+    return x;
+}
+
+// 單一像素（純量參考路徑）
+static inline uint32_t circle_raster_pixel(const struct circle_raster_ctx *ctx, float dx, float dy2)
+{
+    float distance = sqrtf(dx * dx + dy2);
+    if (distance < ctx->band_lo || distance > ctx->band_hi) return 0;
+
+    float t = clampf((distance - ctx->in_e0) / ctx->in_w, 0.0f, 1.0f);
+    float fade_in = t * t * (3.0f - 2.0f * t);
+    t = clampf((distance - ctx->out_e0) / ctx->out_w, 0.0f, 1.0f);
+    float fade_out = t * t * (3.0f - 2.0f * t);
+    float alpha_multiplier = fade_in * (1.0f - fade_out);
+    return ctx->rgb | ((uint32_t)(uint8_t)(ctx->a * alpha_multiplier) << 24);
+}
+
+static void circle_raster_row_scalar(const struct circle_raster_ctx *ctx, float dy2, int lo, int hi, uint32_t *half)
+{
+    for (int x = lo; x <= hi; ++x) half[x] = circle_raster_pixel(ctx, (float)x, dy2);
+}
+
+#ifdef CIRCLE_RASTER_X86
+// ---------------------------------------------------------------------------
+// SSE2
+
+#define CR_FN(name) name##_sse2
+#define CR_TARGET CR_SSE2_TARGET
+#define CR_WIDTH 4
+#define vf __m128
+#define vi __m128i
+#define vf_set1 _mm_set1_ps
+#define vf_add _mm_add_ps
+#define vf_sub _mm_sub_ps
+#define vf_mul _mm_mul_ps
+#define vf_div _mm_div_ps
+#define vf_min _mm_min_ps
+#define vf_max _mm_max_ps
+#define vf_sqrt _mm_sqrt_ps
+#define vf_ge _mm_cmpge_ps
+#define vf_le _mm_cmple_ps
+#define vf_and _mm_and_ps
+#define vf_ramp(b) _mm_add_ps(_mm_set1_ps(b), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f))
+#define vi_set1 _mm_set1_epi32
+#define vi_from_vf _mm_cvttps_epi32
+#define vi_or _mm_or_si128
+#define vi_and_mask(v, m) _mm_and_si128((v), _mm_castps_si128(m))
+#define vi_shl24(v) _mm_slli_epi32((v), 24)
+#define vi_store(p, v) _mm_storeu_si128((__m128i *)(p), (v))
+#include "circle_raster_simd.h"
+#undef CR_FN
+#undef CR_TARGET
+#undef CR_WIDTH
+#undef vf
+#undef vi
+#undef vf_set1
+#undef vf_add
+#undef vf_sub
+#undef vf_mul
+#undef vf_div
+#undef vf_min
+#undef vf_max
+#undef vf_sqrt
+#undef vf_ge
+#undef vf_le
+#undef vf_and
+#undef vf_ramp
+#undef vi_set1
+#undef vi_from_vf
+#undef vi_or
+#undef vi_and_mask
+#undef vi_shl24
+#undef vi_store
+
+// ---------------------------------------------------------------------------
+// AVX2
+
+#define CR_FN(name) name##_avx2
+#define CR_TARGET CR_AVX2_TARGET
+#define CR_WIDTH 8
+#define vf __m256
+#define vi __m256i
+#define vf_set1 _mm256_set1_ps
+#define vf_add _mm256_add_ps
+#define vf_sub _mm256_sub_ps
+#define vf_mul _mm256_mul_ps
+#define vf_div _mm256_div_ps
+#define vf_min _mm256_min_ps
+#define vf_max _mm256_max_ps
+#define vf_sqrt _mm256_sqrt_ps
+#define vf_ge(a, b) _mm256_cmp_ps((a), (b), _CMP_GE_OQ)
+#define vf_le(a, b) _mm256_cmp_ps((a), (b), _CMP_LE_OQ)
+#define vf_and _mm256_and_ps
+#define vf_ramp(b) _mm256_add_ps(_mm256_set1_ps(b), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f))
+#define vi_set1 _mm256_set1_epi32
+#define vi_from_vf _mm256_cvttps_epi32
+#define vi_or _mm256_or_si256
+#define vi_and_mask(v, m) _mm256_and_si256((v), _mm256_castps_si256(m))
+#define vi_shl24(v) _mm256_slli_epi32((v), 24)
+#define vi_store(p, v) _mm256_storeu_si256((__m256i *)(p), (v))
+#include "circle_raster_simd.h"
+#undef CR_FN
+#undef CR_TARGET
+#undef CR_WIDTH
+#undef vf
+#undef vi
+#undef vf_set1
+#undef vf_add
+#undef vf_sub
+#undef vf_mul
+#undef vf_div
+#undef vf_min
+#undef vf_max
+#undef vf_sqrt
+#undef vf_ge
+#undef vf_le
+#undef vf_and
+#undef vf_ramp
+#undef vi_set1
+#undef vi_from_vf
+#undef vi_or
+#undef vi_and_mask
+#undef vi_shl24
+#undef vi_store
+
+static bool cpu_has_avx2(void)
+{
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    // 需要作業系統保存 YMM 暫存器
+    if (!(regs[2] & (1 << 27)) || !(regs[2] & (1 << 28))) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif // CIRCLE_RASTER_X86
+
+enum circle_raster_isa circle_raster_resolve_isa(enum circle_raster_isa isa)
+{
+#ifdef CIRCLE_RASTER_X86
+    // 偵測結果只需計算一次；多執行緒同時寫入的值相同
+    static volatile int avx2 = -1;
+    if (avx2 < 0) avx2 = cpu_has_avx2() ? 1 : 0;
+    if (isa == CIRCLE_RASTER_ISA_AUTO) return avx2 ? CIRCLE_RASTER_ISA_AVX2 : CIRCLE_RASTER_ISA_SSE2;
+    if (isa == CIRCLE_RASTER_ISA_AVX2 && !avx2) return CIRCLE_RASTER_ISA_SSE2;
+    return isa;
+#else
+    (void)isa;
+    return CIRCLE_RASTER_ISA_SCALAR;
+#endif
+}
+
+// 可能不透明的區段：距離落在 [inner - edge, outer + edge] 的 x 範圍（保守估計，精確判斷在核心內）
+static void circle_raster_span(const struct circle_raster_ctx *ctx, int ky, int max_x, int *lo, int *hi)
+{
+    double dy2 = (double)ky * ky;
+    double outer2 = (double)ctx->band_hi * ctx->band_hi;
+    *hi = outer2 > dy2 ? (int)sqrt(outer2 - dy2) + 1 : 0;
+    if (*hi > max_x) *hi = max_x;
+
+    *lo = 0;
+    if (ctx->band_lo > 0.0f) {
+        double inner2 = (double)ctx->band_lo * ctx->band_lo;
+        if (inner2 > dy2) *lo = (int)sqrt(inner2 - dy2) - 1;
+        if (*lo < 0) *lo = 0;
+    }
+}
+
+uint8_t *circle_raster_ring_isa(int radius, int thickness, uint32_t color, float alpha, uint32_t *size,
+                                enum circle_raster_isa isa)
+{
+    int texture_size = (radius + thickness) * 2;
+    *size = texture_size > 0 ? (uint32_t)texture_size : 0;
+    if (texture_size <= 0) return NULL;
+    size_t bytes = (size_t)texture_size * texture_size * 4;
+    uint32_t *data = bmalloc(bytes);
+    memset(data, 0, bytes);
+
+    const float edge_distance = 1.0f;
+    float inner_radius = (float)radius;
+    float outer_radius = (float)(radius + thickness);
+    struct circle_raster_ctx ctx;
+    ctx.band_lo = inner_radius - edge_distance;
+    ctx.band_hi = outer_radius + edge_distance;
+    ctx.in_e0 = inner_radius;
+    ctx.in_w = (inner_radius + edge_distance) - inner_radius;
+    ctx.out_e0 = outer_radius - edge_distance;
+    ctx.out_w = outer_radius - (outer_radius - edge_distance);
+    ctx.a = (uint8_t)(alpha * 255);
+    ctx.rgb = ((color >> 16) & 0xFF) | (((color >> 8) & 0xFF) << 8) | ((color & 0xFF) << 16);
+
+    void (*row_fn)(const struct circle_raster_ctx *, float, int, int, uint32_t *) = circle_raster_row_scalar;
+#ifdef CIRCLE_RASTER_X86
+    switch (circle_raster_resolve_isa(isa)) {
+    case CIRCLE_RASTER_ISA_SSE2: row_fn = circle_raster_row_sse2; break;
+    case CIRCLE_RASTER_ISA_AVX2: row_fn = circle_raster_row_avx2; break;
+    default: break;
+    }
+#else
+    (void)isa;
+#endif
+
+    // 紋理中心落在整數座標 c：像素 x 與 2c - x 對稱，x = 0 的一欄與 y = 0 的一列沒有鏡像
+    int c = texture_size / 2;
+    uint32_t *half = bmalloc(sizeof(uint32_t) * (size_t)(c + 1 + CIRCLE_RASTER_PAD));
+
+    for (int ky = 0; ky <= c; ++ky) {
+        int lo, hi;
+        circle_raster_span(&ctx, ky, c, &lo, &hi);
+        if (lo > hi) continue;
+
+        float dy = (float)ky;
+        row_fn(&ctx, dy * dy, lo, hi, half);
+
+        // 右半邊 x = c + kx（kx < c），左半邊 x = c - kx（kx >= 1），只寫入區段內的像素
+        uint32_t *row = data + (size_t)(c - ky) * texture_size;
+        int right_hi = hi < c - 1 ? hi : c - 1;
+        if (lo <= right_hi) memcpy(row + c + lo, half + lo, sizeof(uint32_t) * (size_t)(right_hi - lo + 1));
+        for (int kx = lo > 1 ? lo : 1; kx <= hi; ++kx) row[c - kx] = half[kx];
+
+        if (ky > 0 && ky < c) {
+            uint32_t *mirror = data + (size_t)(c + ky) * texture_size;
+            memcpy(mirror + c - hi, row + c - hi, sizeof(uint32_t) * (size_t)(hi + right_hi + 1));
+        }
+    }
+
+    bfree(half);
+    return (uint8_t *)data;
+}
+
+uint8_t *circle_raster_ring(int radius, int thickness, uint32_t color, float alpha, uint32_t *size)
+{
+    return circle_raster_ring_isa(radius, thickness, color, alpha, size, CIRCLE_RASTER_ISA_AUTO);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+// 圓環的 CPU 點陣化（SDF 形狀效果無法使用時的後備紋理）
+// 只產生 RGBA 像素資料，不需要圖形上下文，可在背景執行緒執行。
+// 圓環對中心對稱，只計算右下象限的每一列再鏡射到四個象限；
+// 每列只處理可能不透明的區段（跳過內圈的洞與外圈以外），區段內以 SSE2 / AVX2 一次計算 4 / 8 個像素。
+// 所有指令集的輸出都與逐像素的純量版本逐位元相同。
+
+enum circle_raster_isa {
+    CIRCLE_RASTER_ISA_AUTO = 0,
+    CIRCLE_RASTER_ISA_SCALAR,
+    CIRCLE_RASTER_ISA_SSE2,
+    CIRCLE_RASTER_ISA_AVX2,
+};
+
+// 產生邊長 size = (radius + thickness) * 2 的抗鋸齒圓環，回傳以 bfree 釋放的像素資料
+uint8_t *circle_raster_ring(int radius, int thickness, uint32_t color, float alpha, uint32_t *size);
+// 指定指令集（CPU 不支援時自動降級），供效能測試比較
+uint8_t *circle_raster_ring_isa(int radius, int thickness, uint32_t color, float alpha, uint32_t *size,
+                                enum circle_raster_isa isa);
+// 實際使用的指令集（AUTO 會依 CPU 支援選擇）
+enum circle_raster_isa circle_raster_resolve_isa(enum circle_raster_isa isa);
@@ -0,0 +1,43 @@
+// 圓環點陣化的 SIMD 列核心範本，由 circle_raster.c 以不同指令集展開
+// 展開前需定義：
+//   CR_FN(name)  函式名稱後綴
+//   CR_TARGET    函式的目標指令集屬性
+//   CR_WIDTH     每個向量的 lane 數
+//   vf / vi      浮點 / 整數向量型別
+//   vf_set1 / vf_add / vf_sub / vf_mul / vf_div / vf_min / vf_max / vf_sqrt / vf_ge / vf_le / vf_and
+//   vf_ramp(base)  (base, base + 1, ...)
+//   vi_set1 / vi_from_vf（截斷）/ vi_or / vi_and_mask(v, mask) / vi_shl24 / vi_store
+// 運算順序刻意與 circle_raster_pixel 相同，讓輸出逐位元一致。
+
+static CR_TARGET void CR_FN(circle_raster_row)(const struct circle_raster_ctx *ctx, float dy2, int lo, int hi,
+                                               uint32_t *half)
+{
+    const vf zero = vf_set1(0.0f);
+    const vf one = vf_set1(1.0f);
+    const vf three = vf_set1(3.0f);
+    const vf two = vf_set1(2.0f);
+    const vf vdy2 = vf_set1(dy2);
+    const vf band_lo = vf_set1(ctx->band_lo);
+    const vf band_hi = vf_set1(ctx->band_hi);
+    const vf in_e0 = vf_set1(ctx->in_e0);
+    const vf in_w = vf_set1(ctx->in_w);
+    const vf out_e0 = vf_set1(ctx->out_e0);
+    const vf out_w = vf_set1(ctx->out_w);
+    const vf a = vf_set1((float)ctx->a);
+    const vi rgb = vi_set1((int32_t)ctx->rgb);
+
+    for (int x = lo; x <= hi; x += CR_WIDTH) {
+        vf dx = vf_ramp((float)x);
+        vf distance = vf_sqrt(vf_add(vf_mul(dx, dx), vdy2));
+        vf band = vf_and(vf_ge(distance, band_lo), vf_le(distance, band_hi));
+
+        vf t = vf_min(vf_max(vf_div(vf_sub(distance, in_e0), in_w), zero), one);
+        vf fade_in = vf_mul(vf_mul(t, t), vf_sub(three, vf_mul(two, t)));
+        t = vf_min(vf_max(vf_div(vf_sub(distance, out_e0), out_w), zero), one);
+        vf fade_out = vf_mul(vf_mul(t, t), vf_sub(three, vf_mul(two, t)));
+        vf multiplier = vf_mul(fade_in, vf_sub(one, fade_out));
+
+        vi pixel = vi_or(vi_shl24(vi_from_vf(vf_mul(a, multiplier))), rgb);
+        vi_store(half + x, vi_and_mask(pixel, band));
+    }
+}
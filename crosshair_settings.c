@@ -0,0 +1,211 @@
+#include "crosshair_settings.h"
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <string.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+static uint32_t obs_color_to_uint32(uint32_t obs_color)
+{
+    // OBS 顏色格式: RGBA
+    // 我們需要轉換為 ARGB 格式
+    uint8_t r = (obs_color >> 0) & 0xFF;
+    uint8_t g = (obs_color >> 8) & 0xFF;
+    uint8_t b = (obs_color >> 16) & 0xFF;
+    uint8_t a = (obs_color >> 24) & 0xFF;
+    
+    // 轉換為 ARGB 格式
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+// 依曲線設定烘焙查表；自訂控制點格式錯誤時退回線性
+static void bake_response_curve(struct response_curve *curve, obs_data_t *settings, const char *preset_key,
+                                const char *bezier_key)
+{
+    int preset = (int)obs_data_get_int(settings, preset_key);
+    float points[4];
+    bool has_points = response_curve_parse_bezier(obs_data_get_string(settings, bezier_key), points);
+    if (preset == RESPONSE_CURVE_CUSTOM && !has_points) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法解析曲線控制點 %s，改用線性", bezier_key);
+    }
+    response_curve_bake(curve, preset, has_points ? points : NULL);
+}
+
+struct crosshair_settings *crosshair_settings_create(obs_data_t *settings)
+{
+    struct crosshair_settings *s = bzalloc(sizeof(struct crosshair_settings));
+    s->mode = (enum crosshair_mode)obs_data_get_int(settings, "crosshair_mode");
+    s->coordinate_monitor = (int)obs_data_get_int(settings, "coordinate_monitor");
+
+    s->box_size = (int)obs_data_get_int(settings, "box_size");
+    s->box_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "box_color"));
+    s->box_thickness = (int)obs_data_get_int(settings, "box_thickness");
+    s->box_alpha = obs_data_get_bool(settings, "show_box") ? (float)obs_data_get_double(settings, "box_alpha") : 0.0f;
+
+    s->show_default_crosshair = obs_data_get_bool(settings, "show_default_crosshair");
+    s->crosshair_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "crosshair_color"));
+    s->crosshair_thickness = (int)obs_data_get_int(settings, "crosshair_thickness");
+    s->crosshair_alpha = (float)obs_data_get_double(settings, "crosshair_alpha");
+    s->crosshair_size = (int)obs_data_get_int(settings, "crosshair_size");
+
+    s->circle_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "circle_color"));
+    s->circle_thickness = (int)obs_data_get_int(settings, "circle_thickness");
+    s->circle_alpha = (float)obs_data_get_double(settings, "circle_alpha");
+    s->circle_radius = (int)obs_data_get_int(settings, "circle_radius");
+
+    s->crosshair_path = bstrdup(obs_data_get_string(settings, "crosshair_path"));
+    s->show_image = s->show_default_crosshair && s->crosshair_path && *s->crosshair_path;
+    s->play_image_sequence = obs_data_get_bool(settings, "play_image_sequence");
+    s->image_sequence_fps = (float)obs_data_get_double(settings, "image_sequence_fps");
+    s->image_scale = (float)obs_data_get_double(settings, "image_scale");
+    s->image_rotation = (float)obs_data_get_double(settings, "image_rotation");
+
+    s->recenter_speed_center = (float)obs_data_get_double(settings, "recenter_speed_center");
+    s->recenter_speed_edge = (float)obs_data_get_double(settings, "recenter_speed_edge");
+    s->crosshair_move_speed_center = (float)obs_data_get_double(settings, "crosshair_move_speed_center");
+    s->crosshair_move_speed_edge = (float)obs_data_get_double(settings, "crosshair_move_speed_edge");
+    bake_response_curve(&s->move_speed_curve, settings, "move_speed_curve", "move_speed_bezier");
+    bake_response_curve(&s->recenter_curve, settings, "recenter_curve", "recenter_bezier");
+    bake_response_curve(&s->idle_boost_curve, settings, "idle_boost_curve", "idle_boost_bezier");
+    s->sensitivity = (float)obs_data_get_double(settings, "sensitivity");
+    s->max_offset = (int)obs_data_get_int(settings, "max_offset");
+    s->enable_idle_recenter = obs_data_get_bool(settings, "enable_idle_recenter");
+    s->idle_recenter_delay = (float)obs_data_get_double(settings, "idle_recenter_delay");
+    s->idle_recenter_time = (float)obs_data_get_double(settings, "idle_recenter_time");
+    s->idle_recenter_boost = (float)obs_data_get_double(settings, "idle_recenter_boost");
+
+    s->input_sample_rate = (int)obs_data_get_int(settings, "input_sample_rate");
+    s->use_raw_input = obs_data_get_bool(settings, "use_raw_input");
+
+    s->show_tracking_line = obs_data_get_bool(settings, "show_tracking_line");
+    s->tracking_line_mode = (enum tracking_line_mode)obs_data_get_int(settings, "tracking_line_mode");
+    s->tracking_line_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "tracking_line_color"));
+    s->tracking_line_thickness = (int)obs_data_get_int(settings, "tracking_line_thickness");
+    s->tracking_line_alpha = (float)obs_data_get_double(settings, "tracking_line_alpha");
+
+    s->path_circle_radius = (float)obs_data_get_int(settings, "path_circle_radius");
+    s->path_lifetime = (float)obs_data_get_double(settings, "path_lifetime");
+    s->path_generation_interval = (float)obs_data_get_double(settings, "path_generation_interval");
+    s->path_circle_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "path_circle_color"));
+    s->path_max_points = (int)obs_data_get_int(settings, "path_max_points");
+
+    s->ribbon_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "ribbon_color"));
+    s->ribbon_width = (float)obs_data_get_double(settings, "ribbon_width");
+    s->ribbon_full_speed = (float)obs_data_get_double(settings, "ribbon_full_speed");
+    s->ribbon_simplify_tolerance = (float)obs_data_get_double(settings, "ribbon_simplify_tolerance");
+
+    s->show_stats_overlay = obs_data_get_bool(settings, "show_stats_overlay");
+    return s;
+}
+
+void crosshair_settings_destroy(struct crosshair_settings *s)
+{
+    if (!s) return;
+    bfree(s->crosshair_path);
+    bfree(s);
+}
+
+#define SETTING_CHANGED(field) (old->field != cur->field)
+
+uint32_t crosshair_settings_diff(const struct crosshair_settings *old, const struct crosshair_settings *cur)
+{
+    if (!old) return CROSSHAIR_DIRTY_ALL;
+
+    uint32_t dirty = 0;
+    // 後備紋理只在顯示準心時使用，切換回準心時需要重新點陣化
+    if (SETTING_CHANGED(circle_radius) || SETTING_CHANGED(circle_thickness) || SETTING_CHANGED(circle_color) ||
+        SETTING_CHANGED(circle_alpha) || SETTING_CHANGED(show_default_crosshair)) {
+        dirty |= CROSSHAIR_DIRTY_CIRCLE;
+    }
+    if (SETTING_CHANGED(path_max_points) || SETTING_CHANGED(tracking_line_mode) ||
+        SETTING_CHANGED(show_tracking_line)) {
+        dirty |= CROSSHAIR_DIRTY_PATH;
+    }
+    if (SETTING_CHANGED(show_image) || SETTING_CHANGED(image_scale) || SETTING_CHANGED(play_image_sequence) ||
+        strcmp(old->crosshair_path ? old->crosshair_path : "", cur->crosshair_path ? cur->crosshair_path : "") != 0) {
+        dirty |= CROSSHAIR_DIRTY_IMAGE;
+    }
+    if (SETTING_CHANGED(input_sample_rate) || SETTING_CHANGED(use_raw_input) || SETTING_CHANGED(mode)) {
+        dirty |= CROSSHAIR_DIRTY_SAMPLER;
+    }
+
+    // 只影響移動的設定（速度、曲線、靈敏度、螢幕選擇）不會改變已快取的畫面
+    if ((dirty & (CROSSHAIR_DIRTY_CIRCLE | CROSSHAIR_DIRTY_PATH | CROSSHAIR_DIRTY_IMAGE)) ||
+        SETTING_CHANGED(box_size) || SETTING_CHANGED(box_color) || SETTING_CHANGED(box_thickness) ||
+        SETTING_CHANGED(box_alpha) || SETTING_CHANGED(crosshair_color) || SETTING_CHANGED(crosshair_thickness) ||
+        SETTING_CHANGED(crosshair_alpha) || SETTING_CHANGED(crosshair_size) || SETTING_CHANGED(image_rotation) ||
+        SETTING_CHANGED(tracking_line_color) || SETTING_CHANGED(tracking_line_thickness) ||
+        SETTING_CHANGED(tracking_line_alpha) || SETTING_CHANGED(path_circle_radius) ||
+        SETTING_CHANGED(path_circle_color) || SETTING_CHANGED(path_lifetime) || SETTING_CHANGED(ribbon_color) ||
+        SETTING_CHANGED(ribbon_width) || SETTING_CHANGED(ribbon_full_speed)) {
+        dirty |= CROSSHAIR_DIRTY_STATIC_LAYER;
+    }
+    return dirty;
+}
+
+#undef SETTING_CHANGED
+
+void crosshair_settings_buffer_init(struct crosshair_settings_buffer *buf, struct crosshair_settings *initial)
+{
+    buf->slots[0] = initial;
+    buf->slots[1] = NULL;
+    buf->current = 0;
+    buf->pins[0] = 0;
+    buf->pins[1] = 0;
+    pthread_mutex_init(&buf->write_mutex, NULL);
+}
+
+void crosshair_settings_buffer_free(struct crosshair_settings_buffer *buf)
+{
+    crosshair_settings_destroy(buf->slots[0]);
+    crosshair_settings_destroy(buf->slots[1]);
+    buf->slots[0] = NULL;
+    buf->slots[1] = NULL;
+    pthread_mutex_destroy(&buf->write_mutex);
+}
+
+const struct crosshair_settings *crosshair_settings_acquire(struct crosshair_settings_buffer *buf, long *slot)
+{
+    // 先登記再確認 current 沒有變：登記之後寫入端就不會覆寫這個槽；
+    // 若在登記前已切換，取消登記重試（寫入端只會在發佈時切換，重試次數有限）
+    for (;;) {
+        long current = os_atomic_load_long(&buf->current);
+        os_atomic_inc_long(&buf->pins[current]);
+        if (os_atomic_load_long(&buf->current) == current) {
+            *slot = current;
+            return buf->slots[current];
+        }
+        os_atomic_dec_long(&buf->pins[current]);
+    }
+}
+
+void crosshair_settings_release(struct crosshair_settings_buffer *buf, long slot)
+{
+    os_atomic_dec_long(&buf->pins[slot]);
+}
+
+void crosshair_settings_lock(struct crosshair_settings_buffer *buf)
+{
+    pthread_mutex_lock(&buf->write_mutex);
+}
+
+void crosshair_settings_unlock(struct crosshair_settings_buffer *buf)
+{
+    pthread_mutex_unlock(&buf->write_mutex);
+}
+
+uint32_t crosshair_settings_publish(struct crosshair_settings_buffer *buf, struct crosshair_settings *next)
+{
+    long current = os_atomic_load_long(&buf->current);
+    long target = 1 - current;
+    uint32_t dirty = crosshair_settings_diff(buf->slots[current], next);
+
+    // 等待仍持有上上一份快照的讀取者（最多一次 tick 或 render 的時間）
+    while (os_atomic_load_long(&buf->pins[target]) > 0) {
+        os_sleep_ms(1);
+    }
+    crosshair_settings_destroy(buf->slots[target]);
+    buf->slots[target] = next;
+    os_atomic_set_long(&buf->current, target);
+    return dirty;
+}
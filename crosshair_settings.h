@@ -0,0 +1,125 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <obs-module.h>
+#include <util/threading.h>
+#include "response_curve.h"
+
+// 準心運作模式
+enum crosshair_mode {
+    MODE_MOVEMENT = 0,  // 移動模式（原有的移動+回彈）
+    MODE_COORDINATE = 1 // 座標模式（根據滑鼠位置）
+};
+
+// 追蹤線模式
+enum tracking_line_mode {
+    TRACKING_MODE_LINEAR = 0,  // 線性模式（原有的直線）
+    TRACKING_MODE_PATH = 1,    // 路徑模式（生成小圈路徑）
+    TRACKING_MODE_RIBBON = 2   // 緞帶模式（平滑曲線，寬度隨速度變化）
+};
+
+// 設定變更後需要重建的資源
+enum crosshair_dirty {
+    CROSSHAIR_DIRTY_CIRCLE = 1 << 0,       // 圓形後備紋理
+    CROSSHAIR_DIRTY_PATH = 1 << 1,         // 路徑點 / 緞帶緩衝區容量
+    CROSSHAIR_DIRTY_IMAGE = 1 << 2,        // 自訂圖片紋理、動畫與檔案監看
+    CROSSHAIR_DIRTY_SAMPLER = 1 << 3,      // 共用取樣執行緒的頻率與原始輸入
+    CROSSHAIR_DIRTY_STATIC_LAYER = 1 << 4, // 靜態畫面快取（任何影響畫面的設定）
+    CROSSHAIR_DIRTY_ALL = (1 << 5) - 1,
+};
+
+// 一次解析完成的設定；建立後不再修改，變更時整份替換
+struct crosshair_settings {
+    enum crosshair_mode mode;
+    int coordinate_monitor; // 座標模式的螢幕選擇（enum coordinate_monitor 或螢幕索引）
+    // 方框
+    int box_size;
+    uint32_t box_color;
+    int box_thickness;
+    float box_alpha; // 方框透明度（未顯示時為 0）
+    // 準心
+    bool show_default_crosshair;
+    uint32_t crosshair_color;
+    int crosshair_thickness;
+    float crosshair_alpha;
+    int crosshair_size;
+    // 圓圈
+    uint32_t circle_color;
+    int circle_thickness;
+    float circle_alpha;
+    int circle_radius;
+    // 自訂圖片
+    char *crosshair_path;
+    bool show_image; // 顯示自訂圖片且路徑不為空
+    bool play_image_sequence; // 數字結尾的圖片播放連號序列（預設關閉，只顯示選取的檔案）
+    float image_sequence_fps;
+    float image_scale;    // 自訂圖片縮放（1 = 原尺寸）
+    float image_rotation; // 自訂圖片旋轉角度（度，順時針）
+    // 移動
+    float recenter_speed_center; // 中心回彈速度比例 (0.0 = 0%, 20.0 = 2000%)
+    float recenter_speed_edge;   // 外圍回彈速度比例 (0.0 = 0%, 20.0 = 2000%)
+    float crosshair_move_speed_center; // 準心中心移速 (0.0 = 0%, 20.0 = 2000%)
+    float crosshair_move_speed_edge;   // 準心外圍移速 (0.0 = 0%, 20.0 = 2000%)
+    struct response_curve move_speed_curve; // 速度反應曲線（解析時烘焙成查表）
+    struct response_curve recenter_curve;
+    struct response_curve idle_boost_curve;
+    float sensitivity;
+    int max_offset;
+    bool enable_idle_recenter;  // 是否啟用靜止回彈加速
+    float idle_recenter_delay;  // 開始加速前的延遲時間（秒）
+    float idle_recenter_time;   // 回彈加速時間（秒）
+    float idle_recenter_boost;  // 靜止回彈速度增加值 (0.5 = +50%, 1.0 = +100%)
+    // 輸入取樣
+    int input_sample_rate;
+    bool use_raw_input; // 移動模式使用原始相對輸入
+    // 追蹤線
+    bool show_tracking_line;
+    enum tracking_line_mode tracking_line_mode;
+    uint32_t tracking_line_color;
+    int tracking_line_thickness;
+    float tracking_line_alpha;
+    // 路徑模式
+    float path_circle_radius;
+    float path_lifetime;
+    float path_generation_interval; // 距離間隔（像素）
+    uint32_t path_circle_color;
+    int path_max_points; // 路徑點容量上限
+    // 緞帶模式（共用路徑的存活時間與點數上限）
+    uint32_t ribbon_color;
+    float ribbon_width;              // 最大寬度（像素）
+    float ribbon_full_speed;         // 達到最大寬度的速度（像素 / 秒）
+    float ribbon_simplify_tolerance; // 軌跡簡化容差（像素，0 = 不簡化）
+    // 除錯
+    bool show_stats_overlay; // 在來源內顯示執行期統計
+};
+
+struct crosshair_settings *crosshair_settings_create(obs_data_t *settings);
+void crosshair_settings_destroy(struct crosshair_settings *s);
+// 比較新舊設定，回傳需要重建的資源（enum crosshair_dirty）；old 為 NULL 時全部重建
+uint32_t crosshair_settings_diff(const struct crosshair_settings *old, const struct crosshair_settings *cur);
+
+// 設定快照的雙緩衝發佈
+// 寫入端（update）把新快照放進目前未發佈的槽，再以原子操作切換 current；讀取端（tick / render / 尺寸查詢）
+// 只遞增所讀槽的計數，不取鎖。寫入端覆寫一個槽之前會等到該槽沒有讀取者，因此讀取期間快照（含路徑字串）
+// 不會被釋放或修改。寫入端之間以互斥鎖序列化。
+struct crosshair_settings_buffer {
+    struct crosshair_settings *slots[2];
+    volatile long current;  // 目前發佈的槽
+    volatile long pins[2];  // 各槽正在讀取的數量
+    pthread_mutex_t write_mutex;
+};
+
+// 取得 initial 的所有權
+void crosshair_settings_buffer_init(struct crosshair_settings_buffer *buf, struct crosshair_settings *initial);
+// 需在沒有讀取者時呼叫
+void crosshair_settings_buffer_free(struct crosshair_settings_buffer *buf);
+
+// 讀取端：取得目前的快照，使用完畢後以同一個 slot 釋放；不會阻塞
+const struct crosshair_settings *crosshair_settings_acquire(struct crosshair_settings_buffer *buf, long *slot);
+void crosshair_settings_release(struct crosshair_settings_buffer *buf, long slot);
+
+// 寫入端：發佈期間與其後依新設定重建資源時需持有寫入鎖
+void crosshair_settings_lock(struct crosshair_settings_buffer *buf);
+void crosshair_settings_unlock(struct crosshair_settings_buffer *buf);
+// 發佈 next（取得所有權）並回傳與前一份設定的差異；可能短暫等待仍在讀取舊槽的 tick / render
+uint32_t crosshair_settings_publish(struct crosshair_settings_buffer *buf, struct crosshair_settings *next);
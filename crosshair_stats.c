@@ -0,0 +1,87 @@
+#include "crosshair_stats.h"
+#include <string.h>
+
+void crosshair_stats_init(struct crosshair_stats *stats, uint64_t now_ns)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->interval_start = now_ns;
+    pthread_mutex_init(&stats->mutex, NULL);
+}
+
+void crosshair_stats_free(struct crosshair_stats *stats)
+{
+    pthread_mutex_destroy(&stats->mutex);
+}
+
+void crosshair_stats_add_rebuild(struct crosshair_stats *stats)
+{
+    os_atomic_inc_long(&stats->rebuilds);
+}
+
+void crosshair_stats_record_tick(struct crosshair_stats *stats, uint64_t elapsed_ns)
+{
+    stats->tick_ns += elapsed_ns;
+    stats->ticks++;
+}
+
+void crosshair_stats_record_render(struct crosshair_stats *stats, uint64_t elapsed_ns, uint32_t draw_calls)
+{
+    stats->render_ns += elapsed_ns;
+    stats->renders++;
+    stats->draw_calls += draw_calls;
+}
+
+bool crosshair_stats_due(const struct crosshair_stats *stats, uint64_t now_ns)
+{
+    return now_ns - stats->interval_start >= CROSSHAIR_STATS_INTERVAL_NS;
+}
+
+void crosshair_stats_publish(struct crosshair_stats *stats, uint64_t now_ns, long long live_points,
+                             long long texture_bytes, double ribbon_reduction)
+{
+    uint64_t elapsed = now_ns - stats->interval_start;
+    if (elapsed == 0) return;
+
+    struct crosshair_stats_snapshot snapshot;
+    snapshot.live_points = live_points;
+    snapshot.texture_bytes = texture_bytes;
+    snapshot.draw_calls = stats->renders ? (double)stats->draw_calls / (double)stats->renders : 0.0;
+    snapshot.rebuilds_per_second =
+        (double)os_atomic_exchange_long(&stats->rebuilds, 0) * 1000000000.0 / (double)elapsed;
+    snapshot.tick_ms = stats->ticks ? (double)stats->tick_ns / (double)stats->ticks / 1000000.0 : 0.0;
+    snapshot.render_ms = stats->renders ? (double)stats->render_ns / (double)stats->renders / 1000000.0 : 0.0;
+    snapshot.ribbon_reduction = ribbon_reduction;
+
+    pthread_mutex_lock(&stats->mutex);
+    stats->snapshot = snapshot;
+    pthread_mutex_unlock(&stats->mutex);
+
+    stats->interval_start = now_ns;
+    stats->tick_ns = 0;
+    stats->ticks = 0;
+    stats->render_ns = 0;
+    stats->renders = 0;
+    stats->draw_calls = 0;
+}
+
+void crosshair_stats_get(struct crosshair_stats *stats, struct crosshair_stats_snapshot *snapshot)
+{
+    pthread_mutex_lock(&stats->mutex);
+    *snapshot = stats->snapshot;
+    pthread_mutex_unlock(&stats->mutex);
+}
+
+void crosshair_stats_format(const struct crosshair_stats_snapshot *snapshot, struct dstr *text)
+{
+    dstr_printf(text,
+                "points    %lld\n"
+                "draws     %.1f / frame\n"
+                "textures  %.2f MB\n"
+                "rebuilds  %.1f / s\n"
+                "tick      %.3f ms\n"
+                "render    %.3f ms\n"
+                "simplify  %.1f %%",
+                snapshot->live_points, snapshot->draw_calls,
+                (double)snapshot->texture_bytes / (1024.0 * 1024.0), snapshot->rebuilds_per_second,
+                snapshot->tick_ms, snapshot->render_ms, snapshot->ribbon_reduction * 100.0);
+}
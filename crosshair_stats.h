@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <util/threading.h>
+#include <util/dstr.h>
+
+// 執行期統計
+// tick 與 render 都在圖形執行緒上累計本區間的時間與繪製呼叫，每隔一段時間由 tick 換算成每秒 / 每幀的
+// 平均值並發佈；proc handler 可能在其他執行緒讀取，發佈的結果以互斥鎖保護，累計中的數值不需同步。
+
+// 統計區間長度
+#define CROSSHAIR_STATS_INTERVAL_NS 500000000ULL
+
+struct crosshair_stats_snapshot {
+    long long live_points;      // 存活的路徑點 / 緞帶取樣點
+    double draw_calls;          // 每次 render 的平均繪製呼叫數
+    long long texture_bytes;    // 模組共用紋理快取與本來源動畫佔用的大小
+    double rebuilds_per_second; // 紋理請求、動畫重新載入與靜態畫面快取重建
+    double tick_ms;             // 每次 tick 的平均 CPU 時間
+    double render_ms;           // 每次 render 的平均 CPU 時間（不含統計覆蓋層）
+    double ribbon_reduction;    // 緞帶簡化累計移除的取樣點比例（0 ~ 1）
+};
+
+struct crosshair_stats {
+    // 本區間的累計值（圖形執行緒）
+    uint64_t interval_start;
+    uint64_t tick_ns;
+    uint64_t ticks;
+    uint64_t render_ns;
+    uint64_t renders;
+    uint64_t draw_calls;
+    volatile long rebuilds; // update 也會遞增，以原子操作累加
+
+    // 最後一次發佈的結果
+    pthread_mutex_t mutex;
+    struct crosshair_stats_snapshot snapshot;
+};
+
+void crosshair_stats_init(struct crosshair_stats *stats, uint64_t now_ns);
+void crosshair_stats_free(struct crosshair_stats *stats);
+
+// 可在任何執行緒呼叫
+void crosshair_stats_add_rebuild(struct crosshair_stats *stats);
+
+// 以下在圖形執行緒上呼叫
+void crosshair_stats_record_tick(struct crosshair_stats *stats, uint64_t elapsed_ns);
+void crosshair_stats_record_render(struct crosshair_stats *stats, uint64_t elapsed_ns, uint32_t draw_calls);
+// 本區間是否已結束；結束時呼叫端收集目前的點數、紋理大小與緞帶簡化比例後發佈
+bool crosshair_stats_due(const struct crosshair_stats *stats, uint64_t now_ns);
+void crosshair_stats_publish(struct crosshair_stats *stats, uint64_t now_ns, long long live_points,
+                             long long texture_bytes, double ribbon_reduction);
+
+// 可在任何執行緒呼叫
+void crosshair_stats_get(struct crosshair_stats *stats, struct crosshair_stats_snapshot *snapshot);
+// 覆蓋層顯示的文字
+void crosshair_stats_format(const struct crosshair_stats_snapshot *snapshot, struct dstr *text);
@@ -0,0 +1,27 @@
+#include "cursor_provider.h"
+#include <obs-module.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+bool cursor_provider_init(struct cursor_provider *provider)
+{
+#ifdef _WIN32
+    provider->ops = &cursor_provider_win32;
+#else
+    provider->ops = &cursor_provider_x11;
+#endif
+    provider->data = provider->ops->create();
+    if (!provider->data) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法初始化滑鼠來源後端: %s", provider->ops->name);
+        return false;
+    }
+    return true;
+}
+
+void cursor_provider_free(struct cursor_provider *provider)
+{
+    if (provider->data) {
+        provider->ops->destroy(provider->data);
+        provider->data = NULL;
+    }
+}
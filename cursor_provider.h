@@ -0,0 +1,86 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// 螢幕矩形（虛擬桌面座標，right / bottom 不含）
+struct cursor_rect {
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+};
+
+// 滑鼠來源後端介面
+// get_position、wait_motion 與原始輸入相關函式只會由同一個執行緒呼叫（取樣執行緒，或取樣執行緒不可用時的 tick）；
+// enum_monitors 與 monitor_generation 只會由 tick 呼叫，後端需自行確保兩組可同時使用。
+struct cursor_provider_ops {
+    const char *name;
+    void *(*create)(void);
+    void (*destroy)(void *data);
+    bool (*get_position)(void *data, int32_t *x, int32_t *y);
+    // 列出所有螢幕範圍，回傳螢幕數量（最多 max_count 個）
+    int (*enum_monitors)(void *data, struct cursor_rect *rects, int max_count);
+    // 螢幕配置世代：收到顯示設定變更事件時遞增，用於讓螢幕快取失效
+    long (*monitor_generation)(void *data);
+    // 選用：後端是否能以事件通知滑鼠移動；NULL 表示只能輪詢
+    bool (*has_motion_events)(void *data);
+    // 選用：阻塞直到有滑鼠移動事件（回傳 true）或逾時（回傳 false）
+    bool (*wait_motion)(void *data, uint64_t timeout_ns);
+    // 選用：開關原始相對輸入（Raw Input / XInput2 RawMotion），回傳是否已啟用
+    bool (*set_raw_input)(void *data, bool enable);
+    // 選用：取出並清除累積的原始相對位移，回傳是否有位移
+    bool (*consume_raw_delta)(void *data, float *dx, float *dy);
+};
+
+struct cursor_provider {
+    const struct cursor_provider_ops *ops;
+    void *data;
+};
+
+#ifdef _WIN32
+extern const struct cursor_provider_ops cursor_provider_win32;
+#else
+extern const struct cursor_provider_ops cursor_provider_x11;
+#endif
+
+// 依平台建立後端
+bool cursor_provider_init(struct cursor_provider *provider);
+void cursor_provider_free(struct cursor_provider *provider);
+
+static inline bool cursor_provider_get_position(struct cursor_provider *provider, int32_t *x, int32_t *y)
+{
+    return provider->data && provider->ops->get_position(provider->data, x, y);
+}
+
+static inline int cursor_provider_enum_monitors(struct cursor_provider *provider, struct cursor_rect *rects,
+                                                int max_count)
+{
+    return provider->data ? provider->ops->enum_monitors(provider->data, rects, max_count) : 0;
+}
+
+static inline long cursor_provider_monitor_generation(struct cursor_provider *provider)
+{
+    return provider->data ? provider->ops->monitor_generation(provider->data) : 0;
+}
+
+static inline bool cursor_provider_has_motion_events(const struct cursor_provider *provider)
+{
+    return provider->data && provider->ops->has_motion_events && provider->ops->wait_motion &&
+           provider->ops->has_motion_events(provider->data);
+}
+
+static inline bool cursor_provider_wait_motion(struct cursor_provider *provider, uint64_t timeout_ns)
+{
+    return provider->ops->wait_motion(provider->data, timeout_ns);
+}
+
+static inline bool cursor_provider_set_raw_input(struct cursor_provider *provider, bool enable)
+{
+    return provider->data && provider->ops->set_raw_input && provider->ops->set_raw_input(provider->data, enable);
+}
+
+static inline bool cursor_provider_consume_raw_delta(struct cursor_provider *provider, float *dx, float *dy)
+{
+    return provider->data && provider->ops->consume_raw_delta &&
+           provider->ops->consume_raw_delta(provider->data, dx, dy);
+}
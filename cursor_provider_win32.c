@@ -0,0 +1,339 @@
+#include "cursor_provider.h"
+#include <obs-module.h>
+#include <util/threading.h>
+#include <windows.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+// Win32 後端：GetCursorPos 取得位置 + EnumDisplayMonitors 列舉螢幕
+// 另以隱藏視窗接收 WM_DISPLAYCHANGE，讓螢幕快取只在顯示設定變更時失效；
+// 啟用原始輸入時同一個視窗也接收 WM_INPUT，累積滑鼠的相對位移並喚醒取樣執行緒。
+struct win32_cursor {
+    pthread_t thread;
+    bool thread_created;
+    os_event_t *ready;
+    HWND hwnd;
+    volatile long monitor_generation;
+    os_event_t *motion;         // 收到原始滑鼠移動時觸發
+    volatile long raw_enabled;
+    volatile long raw_dx;       // 累積的原始位移（mickeys）
+    volatile long raw_dy;
+    struct win32_cursor *raw_next; // 啟用原始輸入的後端串列
+};
+
+// 在監看執行緒上註冊 / 取消原始輸入
+#define WM_DR_SET_RAW_INPUT (WM_APP + 1)
+// 原本的註冊目標視窗關閉後，由下一個使用者的監看執行緒接手註冊
+#define WM_DR_TAKE_RAW_INPUT (WM_APP + 2)
+
+// 滑鼠原始輸入的註冊是整個行程共用的（每個 usage 只能有一個目標視窗）。
+// 所有啟用原始輸入的後端串成一個串列，只在第一個加入時註冊、最後一個離開時移除，
+// 目標視窗收到的位移分給串列中的每個後端。其他模組已註冊滑鼠原始輸入時不覆寫它，
+// 移除前也會確認目前的註冊仍是自己的。
+static pthread_mutex_t raw_input_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct win32_cursor *raw_input_users;
+static HWND raw_input_hwnd; // 目前的註冊目標視窗
+
+static const wchar_t *WATCH_WINDOW_CLASS = L"DRCursorTrackerWatchWindow";
+
+struct monitor_enum_info {
+    struct cursor_rect *rects;
+    int max_count;
+    int count;
+};
+
+static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData)
+{
+    struct monitor_enum_info *info = (struct monitor_enum_info *)dwData;
+    if (info->count >= info->max_count) return FALSE; // 停止枚舉
+    struct cursor_rect *r = &info->rects[info->count++];
+    r->left = lprcMonitor->left;
+    r->top = lprcMonitor->top;
+    r->right = lprcMonitor->right;
+    r->bottom = lprcMonitor->bottom;
+    return TRUE; // 繼續枚舉
+}
+
+// 目前行程中滑鼠原始輸入的註冊目標；沒有註冊時回傳 false
+static bool raw_mouse_registration(HWND *target)
+{
+    UINT count = 0;
+    GetRegisteredRawInputDevices(NULL, &count, sizeof(RAWINPUTDEVICE));
+    if (count == 0) return false;
+
+    RAWINPUTDEVICE *devices = bzalloc(count * sizeof(RAWINPUTDEVICE));
+    UINT n = GetRegisteredRawInputDevices(devices, &count, sizeof(RAWINPUTDEVICE));
+    bool found = false;
+    for (UINT i = 0; i < n && n != (UINT)-1; ++i) {
+        if (devices[i].usUsagePage == 0x01 && devices[i].usUsage == 0x02) {
+            *target = devices[i].hwndTarget;
+            found = true;
+            break;
+        }
+    }
+    bfree(devices);
+    return found;
+}
+
+static bool raw_mouse_register(HWND hwnd)
+{
+    RAWINPUTDEVICE rid;
+    rid.usUsagePage = 0x01; // Generic Desktop
+    rid.usUsage = 0x02;     // Mouse
+    rid.dwFlags = RIDEV_INPUTSINK;
+    rid.hwndTarget = hwnd;
+    return RegisterRawInputDevices(&rid, 1, sizeof(rid)) != 0;
+}
+
+// 加入原始輸入的使用者；需在 w 的監看執行緒上呼叫
+static bool raw_input_add_user(struct win32_cursor *w)
+{
+    bool ok = true;
+    pthread_mutex_lock(&raw_input_mutex);
+    if (!raw_input_users) {
+        HWND target;
+        if (raw_mouse_registration(&target) && target != w->hwnd) {
+            blog(LOG_WARNING, BLOG_PREFIX "滑鼠原始輸入已被其他模組註冊，不覆寫它的設定");
+            ok = false;
+        } else {
+            ok = raw_mouse_register(w->hwnd);
+            if (ok) raw_input_hwnd = w->hwnd;
+        }
+    }
+    if (ok) {
+        w->raw_next = raw_input_users;
+        raw_input_users = w;
+    }
+    pthread_mutex_unlock(&raw_input_mutex);
+    return ok;
+}
+
+// 移除原始輸入的使用者；需在 w 的監看執行緒上呼叫
+static void raw_input_remove_user(struct win32_cursor *w)
+{
+    pthread_mutex_lock(&raw_input_mutex);
+    struct win32_cursor **link = &raw_input_users;
+    while (*link && *link != w) link = &(*link)->raw_next;
+    if (*link) *link = w->raw_next;
+    w->raw_next = NULL;
+
+    if (raw_input_hwnd == w->hwnd) {
+        HWND target;
+        bool ours = raw_mouse_registration(&target) && target == w->hwnd;
+        if (raw_input_users) {
+            // 其餘使用者的視窗屬於其他執行緒，交給它自己重新註冊
+            PostMessageW(raw_input_users->hwnd, WM_DR_TAKE_RAW_INPUT, 0, 0);
+        } else if (ours) {
+            RAWINPUTDEVICE rid = {0x01, 0x02, RIDEV_REMOVE, NULL};
+            RegisterRawInputDevices(&rid, 1, sizeof(rid));
+        }
+        raw_input_hwnd = NULL;
+    }
+    pthread_mutex_unlock(&raw_input_mutex);
+}
+
+// 原本的目標視窗已關閉，由仍在串列中的後端接手註冊
+static void raw_input_take_over(struct win32_cursor *w)
+{
+    pthread_mutex_lock(&raw_input_mutex);
+    bool listed = false;
+    for (struct win32_cursor *u = raw_input_users; u; u = u->raw_next) {
+        if (u == w) listed = true;
+    }
+    if (listed && !raw_input_hwnd && raw_mouse_register(w->hwnd)) raw_input_hwnd = w->hwnd;
+    pthread_mutex_unlock(&raw_input_mutex);
+}
+
+// 把收到的位移分給所有使用者
+static void raw_input_dispatch(LONG dx, LONG dy)
+{
+    pthread_mutex_lock(&raw_input_mutex);
+    for (struct win32_cursor *u = raw_input_users; u; u = u->raw_next) {
+        if (!InterlockedCompareExchange(&u->raw_enabled, 0, 0)) continue;
+        InterlockedExchangeAdd(&u->raw_dx, dx);
+        InterlockedExchangeAdd(&u->raw_dy, dy);
+        os_event_signal(u->motion);
+    }
+    pthread_mutex_unlock(&raw_input_mutex);
+}
+
+static LRESULT CALLBACK watch_window_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
+{
+    struct win32_cursor *w = (struct win32_cursor *)GetWindowLongPtrW(hwnd, GWLP_USERDATA);
+    switch (msg) {
+    case WM_DISPLAYCHANGE:
+        if (w) os_atomic_inc_long(&w->monitor_generation);
+        return 0;
+    case WM_DR_SET_RAW_INPUT:
+        if (!w) return 0;
+        if (wparam) return raw_input_add_user(w) ? 1 : 0;
+        raw_input_remove_user(w);
+        return 1;
+    case WM_DR_TAKE_RAW_INPUT:
+        if (w) raw_input_take_over(w);
+        return 0;
+    case WM_INPUT: {
+        // 絕對座標裝置（繪圖板、遠端桌面）的數值不是相對位移，略過
+        RAWINPUT raw;
+        UINT size = sizeof(raw);
+        if (GetRawInputData((HRAWINPUT)lparam, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) != (UINT)-1 &&
+            raw.header.dwType == RIM_TYPEMOUSE && !(raw.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) &&
+            (raw.data.mouse.lLastX != 0 || raw.data.mouse.lLastY != 0)) {
+            raw_input_dispatch(raw.data.mouse.lLastX, raw.data.mouse.lLastY);
+        }
+        return DefWindowProcW(hwnd, msg, wparam, lparam);
+    }
+    case WM_CLOSE:
+        DestroyWindow(hwnd);
+        return 0;
+    case WM_DESTROY:
+        if (w && InterlockedCompareExchange(&w->raw_enabled, 0, 0)) {
+            InterlockedExchange(&w->raw_enabled, 0);
+            raw_input_remove_user(w);
+        }
+        PostQuitMessage(0);
+        return 0;
+    }
+    return DefWindowProcW(hwnd, msg, wparam, lparam);
+}
+
+static void *watch_thread(void *param)
+{
+    struct win32_cursor *w = param;
+    os_set_thread_name("dr_cursor_tracker: display watch");
+
+    WNDCLASSW wc = {0};
+    wc.lpfnWndProc = watch_window_proc;
+    wc.hInstance = GetModuleHandleW(NULL);
+    wc.lpszClassName = WATCH_WINDOW_CLASS;
+    RegisterClassW(&wc); // 已註冊時會失敗，可忽略
+
+    // 一般隱藏頂層視窗（HWND_MESSAGE 視窗收不到廣播的 WM_DISPLAYCHANGE）
+    w->hwnd = CreateWindowExW(0, WATCH_WINDOW_CLASS, L"", 0, 0, 0, 0, 0, NULL, NULL, wc.hInstance, NULL);
+    if (w->hwnd) SetWindowLongPtrW(w->hwnd, GWLP_USERDATA, (LONG_PTR)w);
+    os_event_signal(w->ready);
+    if (!w->hwnd) return NULL;
+
+    MSG msg;
+    while (GetMessageW(&msg, NULL, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+    return NULL;
+}
+
+static void *win32_create(void)
+{
+    struct win32_cursor *w = bzalloc(sizeof(struct win32_cursor));
+    if (os_event_init(&w->motion, OS_EVENT_TYPE_AUTO) != 0) {
+        bfree(w);
+        return NULL;
+    }
+    if (os_event_init(&w->ready, OS_EVENT_TYPE_MANUAL) == 0) {
+        w->thread_created = pthread_create(&w->thread, NULL, watch_thread, w) == 0;
+        if (w->thread_created) os_event_wait(w->ready);
+    }
+    if (!w->hwnd) {
+        // 沒有視窗時螢幕快取不會自動失效，但仍可正常運作
+        blog(LOG_WARNING, BLOG_PREFIX "無法建立顯示設定監看視窗");
+    }
+    return w;
+}
+
+static void win32_destroy(void *data)
+{
+    struct win32_cursor *w = data;
+    if (w->thread_created) {
+        if (w->hwnd) PostMessageW(w->hwnd, WM_CLOSE, 0, 0);
+        pthread_join(w->thread, NULL);
+    }
+    if (w->ready) os_event_destroy(w->ready);
+    os_event_destroy(w->motion);
+    bfree(w);
+}
+
+static bool win32_get_position(void *data, int32_t *x, int32_t *y)
+{
+    (void)data;
+    POINT pt;
+    if (!GetCursorPos(&pt)) return false;
+    *x = (int32_t)pt.x;
+    *y = (int32_t)pt.y;
+    return true;
+}
+
+static int win32_enum_monitors(void *data, struct cursor_rect *rects, int max_count)
+{
+    (void)data;
+    struct monitor_enum_info info;
+    info.rects = rects;
+    info.max_count = max_count;
+    info.count = 0;
+    EnumDisplayMonitors(NULL, NULL, MonitorEnumProc, (LPARAM)&info);
+    return info.count;
+}
+
+static long win32_monitor_generation(void *data)
+{
+    struct win32_cursor *w = data;
+    return os_atomic_load_long(&w->monitor_generation);
+}
+
+static bool win32_has_motion_events(void *data)
+{
+    struct win32_cursor *w = data;
+    return InterlockedCompareExchange(&w->raw_enabled, 0, 0) != 0;
+}
+
+static bool win32_wait_motion(void *data, uint64_t timeout_ns)
+{
+    struct win32_cursor *w = data;
+    return os_event_timedwait(w->motion, (unsigned long)(timeout_ns / 1000000)) == 0;
+}
+
+static bool win32_set_raw_input(void *data, bool enable)
+{
+    struct win32_cursor *w = data;
+    if (!w->hwnd) return false;
+
+    // 狀態相同時不重複加入 / 移除，讓行程內的使用者計數保持正確
+    bool was_enabled = InterlockedCompareExchange(&w->raw_enabled, 0, 0) != 0;
+    bool ok = true;
+    if (enable != was_enabled) {
+        // 停用時先停止累積，再離開使用者串列
+        if (!enable) InterlockedExchange(&w->raw_enabled, 0);
+        ok = SendMessageW(w->hwnd, WM_DR_SET_RAW_INPUT, enable ? 1 : 0, 0) != 0;
+    }
+    bool active = enable && ok;
+    InterlockedExchange(&w->raw_enabled, active ? 1 : 0);
+    InterlockedExchange(&w->raw_dx, 0);
+    InterlockedExchange(&w->raw_dy, 0);
+    if (enable && !ok) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法註冊原始滑鼠輸入，改用游標位移");
+    }
+    return active;
+}
+
+static bool win32_consume_raw_delta(void *data, float *dx, float *dy)
+{
+    struct win32_cursor *w = data;
+    long x = InterlockedExchange(&w->raw_dx, 0);
+    long y = InterlockedExchange(&w->raw_dy, 0);
+    if (x == 0 && y == 0) return false;
+    *dx = (float)x;
+    *dy = (float)y;
+    return true;
+}
+
+const struct cursor_provider_ops cursor_provider_win32 = {
+    .name = "win32",
+    .create = win32_create,
+    .destroy = win32_destroy,
+    .get_position = win32_get_position,
+    .enum_monitors = win32_enum_monitors,
+    .monitor_generation = win32_monitor_generation,
+    .has_motion_events = win32_has_motion_events,
+    .wait_motion = win32_wait_motion,
+    .set_raw_input = win32_set_raw_input,
+    .consume_raw_delta = win32_consume_raw_delta,
+};
@@ -0,0 +1,280 @@
+#include "cursor_provider.h"
+#include <obs-module.h>
+#include <X11/Xlib.h>
+#include <X11/extensions/XInput2.h>
+#include <X11/extensions/Xrandr.h>
+#include <poll.h>
+#include <string.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+// XInput2 裝置編號上限（伺服器的編號都小於 256）
+#define X11_MAX_DEVICES 256
+
+enum x11_device_mode {
+    X11_DEVICE_UNKNOWN = 0,
+    X11_DEVICE_RELATIVE,
+    X11_DEVICE_ABSOLUTE,
+};
+
+// X11 後端：XInput2 RawMotion 事件驅動，XQueryPointer 取得絕對座標，XRandR 列舉螢幕並通知配置變更
+// 取樣執行緒與 tick 各自使用獨立的 Display 連線，不依賴 XInitThreads。
+struct x11_cursor {
+    Display *event_display; // 取樣執行緒：事件與游標位置
+    Display *query_display; // tick：螢幕範圍
+    Window event_root;
+    Window query_root;
+    int xi_opcode;
+    bool has_xi2;
+    int randr_event_base;
+    bool has_randr_events;
+    long monitor_generation;
+    bool raw_enabled;
+    double raw_dx; // 累積的原始位移，只由取樣執行緒讀寫
+    double raw_dy;
+    // 各實體裝置的 X / Y valuator 是否為絕對座標（繪圖板、觸控螢幕）；裝置變更時清除
+    unsigned char device_mode[X11_MAX_DEVICES];
+};
+
+static bool x11_select_raw_motion(struct x11_cursor *x)
+{
+    int event, error;
+    if (!XQueryExtension(x->event_display, "XInputExtension", &x->xi_opcode, &event, &error)) {
+        return false;
+    }
+
+    // 要求 2.2 並至少需要 2.1：2.0 的 RawMotion 在其他程式抓取指標（例如遊戲鎖定游標）時只送給抓取者，
+    // 事件等待與原始位移都會停住；不足時整個退回輪詢游標位置，移動模式改用游標位移
+    int major = 2, minor = 2;
+    if (XIQueryVersion(x->event_display, &major, &minor) != Success || major != 2 || minor < 1) {
+        return false;
+    }
+
+    // RawMotion 會送到根視窗，與目前焦點視窗無關
+    unsigned char mask_bits[XIMaskLen(XI_LASTEVENT)] = {0};
+    XIEventMask masks[2];
+    masks[0].deviceid = XIAllMasterDevices;
+    masks[0].mask_len = sizeof(mask_bits);
+    masks[0].mask = mask_bits;
+    XISetMask(mask_bits, XI_RawMotion);
+    // 裝置增減或變更時清除絕對座標裝置的快取
+    unsigned char device_bits[XIMaskLen(XI_LASTEVENT)] = {0};
+    masks[1].deviceid = XIAllDevices;
+    masks[1].mask_len = sizeof(device_bits);
+    masks[1].mask = device_bits;
+    XISetMask(device_bits, XI_HierarchyChanged);
+    XISetMask(device_bits, XI_DeviceChanged);
+    XISelectEvents(x->event_display, x->event_root, masks, 2);
+    XFlush(x->event_display);
+    return true;
+}
+
+static void *x11_create(void)
+{
+    struct x11_cursor *x = bzalloc(sizeof(struct x11_cursor));
+    x->event_display = XOpenDisplay(NULL);
+    x->query_display = XOpenDisplay(NULL);
+    if (!x->event_display || !x->query_display) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法連線到 X 伺服器");
+        if (x->event_display) XCloseDisplay(x->event_display);
+        if (x->query_display) XCloseDisplay(x->query_display);
+        bfree(x);
+        return NULL;
+    }
+    x->event_root = DefaultRootWindow(x->event_display);
+    x->query_root = DefaultRootWindow(x->query_display);
+
+    // 訂閱螢幕配置變更通知，讓螢幕快取只在變更時失效
+    int randr_error_base;
+    if (XRRQueryExtension(x->query_display, &x->randr_event_base, &randr_error_base)) {
+        XRRSelectInput(x->query_display, x->query_root,
+                       RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputChangeNotifyMask);
+        x->has_randr_events = true;
+    }
+
+    x->has_xi2 = x11_select_raw_motion(x);
+    if (!x->has_xi2) {
+        blog(LOG_INFO, BLOG_PREFIX "XInput 2.1 以上不可用，改為輪詢游標位置");
+    }
+    return x;
+}
+
+static void x11_destroy(void *data)
+{
+    struct x11_cursor *x = data;
+    XCloseDisplay(x->event_display);
+    XCloseDisplay(x->query_display);
+    bfree(x);
+}
+
+static bool x11_get_position(void *data, int32_t *px, int32_t *py)
+{
+    struct x11_cursor *x = data;
+    Window root_ret, child_ret;
+    int root_x, root_y, win_x, win_y;
+    unsigned int mask;
+    if (!XQueryPointer(x->event_display, x->event_root, &root_ret, &child_ret,
+                       &root_x, &root_y, &win_x, &win_y, &mask)) {
+        return false;
+    }
+    *px = root_x;
+    *py = root_y;
+    return true;
+}
+
+static int x11_enum_monitors(void *data, struct cursor_rect *rects, int max_count)
+{
+    struct x11_cursor *x = data;
+    int count = 0;
+    XRRMonitorInfo *monitors = XRRGetMonitors(x->query_display, x->query_root, True, &count);
+    int n = 0;
+    for (int i = 0; i < count && n < max_count; ++i) {
+        const XRRMonitorInfo *m = &monitors[i];
+        rects[n].left = m->x;
+        rects[n].top = m->y;
+        rects[n].right = m->x + m->width;
+        rects[n].bottom = m->y + m->height;
+        n++;
+    }
+    if (monitors) XRRFreeMonitors(monitors);
+
+    // 沒有 RandR 螢幕資訊時以整個畫面為範圍
+    if (n == 0 && max_count > 0) {
+        int screen = DefaultScreen(x->query_display);
+        rects[0].left = 0;
+        rects[0].top = 0;
+        rects[0].right = DisplayWidth(x->query_display, screen);
+        rects[0].bottom = DisplayHeight(x->query_display, screen);
+        n = 1;
+    }
+    return n;
+}
+
+static long x11_monitor_generation(void *data)
+{
+    struct x11_cursor *x = data;
+    // 處理 query 連線上的 RandR 通知；只有 tick 會使用這個連線
+    while (x->has_randr_events && XPending(x->query_display) > 0) {
+        XEvent ev;
+        XNextEvent(x->query_display, &ev);
+        if (ev.type == x->randr_event_base + RRScreenChangeNotify ||
+            ev.type == x->randr_event_base + RRNotify) {
+            XRRUpdateConfiguration(&ev);
+            x->monitor_generation++;
+        }
+    }
+    return x->monitor_generation;
+}
+
+static bool x11_has_motion_events(void *data)
+{
+    struct x11_cursor *x = data;
+    return x->has_xi2;
+}
+
+// 實體裝置的 X / Y valuator 是否為絕對座標；結果快取到裝置變更為止
+static bool x11_device_is_absolute(struct x11_cursor *x, int deviceid)
+{
+    if (deviceid < 0 || deviceid >= X11_MAX_DEVICES) return false;
+    if (x->device_mode[deviceid] == X11_DEVICE_UNKNOWN) {
+        enum x11_device_mode mode = X11_DEVICE_RELATIVE;
+        int count = 0;
+        XIDeviceInfo *info = XIQueryDevice(x->event_display, deviceid, &count);
+        for (int i = 0; info && i < count; ++i) {
+            for (int c = 0; c < info[i].num_classes; ++c) {
+                const XIAnyClassInfo *any = info[i].classes[c];
+                if (any->type != XIValuatorClass) continue;
+                const XIValuatorClassInfo *v = (const XIValuatorClassInfo *)any;
+                if (v->number <= 1 && v->mode == XIModeAbsolute) mode = X11_DEVICE_ABSOLUTE;
+            }
+        }
+        if (info) XIFreeDeviceInfo(info);
+        x->device_mode[deviceid] = (unsigned char)mode;
+    }
+    return x->device_mode[deviceid] == X11_DEVICE_ABSOLUTE;
+}
+
+// 累加 RawMotion 的原始（未經加速）位移：valuator 0 = X、1 = Y
+// 絕對座標裝置的數值是位置而不是位移，略過
+static void x11_accumulate_raw(struct x11_cursor *x, const XIRawEvent *raw)
+{
+    if (x11_device_is_absolute(x, raw->sourceid)) return;
+
+    const double *value = raw->raw_values;
+    int bits = raw->valuators.mask_len * 8;
+    for (int i = 0; i < bits && i < 2; ++i) {
+        if (!XIMaskIsSet(raw->valuators.mask, i)) continue;
+        if (i == 0) x->raw_dx += *value;
+        else x->raw_dy += *value;
+        value++;
+    }
+}
+
+// 處理所有待處理事件，回傳是否包含滑鼠移動
+static bool x11_drain_events(struct x11_cursor *x)
+{
+    bool moved = false;
+    while (XPending(x->event_display) > 0) {
+        XEvent ev;
+        XNextEvent(x->event_display, &ev);
+        XGenericEventCookie *cookie = &ev.xcookie;
+        if (cookie->type == GenericEvent && cookie->extension == x->xi_opcode &&
+            XGetEventData(x->event_display, cookie)) {
+            if (cookie->evtype == XI_RawMotion) {
+                moved = true;
+                if (x->raw_enabled) x11_accumulate_raw(x, cookie->data);
+            } else if (cookie->evtype == XI_HierarchyChanged || cookie->evtype == XI_DeviceChanged) {
+                memset(x->device_mode, 0, sizeof(x->device_mode));
+            }
+            XFreeEventData(x->event_display, cookie);
+        }
+    }
+    return moved;
+}
+
+static bool x11_wait_motion(void *data, uint64_t timeout_ns)
+{
+    struct x11_cursor *x = data;
+    if (x11_drain_events(x)) return true;
+
+    struct pollfd pfd;
+    pfd.fd = ConnectionNumber(x->event_display);
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int timeout_ms = (int)(timeout_ns / 1000000);
+    if (poll(&pfd, 1, timeout_ms) <= 0) return false;
+    return x11_drain_events(x);
+}
+
+static bool x11_set_raw_input(void *data, bool enable)
+{
+    struct x11_cursor *x = data;
+    x->raw_enabled = enable && x->has_xi2;
+    x->raw_dx = x->raw_dy = 0.0;
+    return x->raw_enabled;
+}
+
+static bool x11_consume_raw_delta(void *data, float *dx, float *dy)
+{
+    struct x11_cursor *x = data;
+    // 非阻塞地處理已到達的事件，輪詢模式下也能取得位移
+    x11_drain_events(x);
+    if (x->raw_dx == 0.0 && x->raw_dy == 0.0) return false;
+    *dx = (float)x->raw_dx;
+    *dy = (float)x->raw_dy;
+    x->raw_dx = x->raw_dy = 0.0;
+    return true;
+}
+
+const struct cursor_provider_ops cursor_provider_x11 = {
+    .name = "x11",
+    .create = x11_create,
+    .destroy = x11_destroy,
+    .get_position = x11_get_position,
+    .enum_monitors = x11_enum_monitors,
+    .monitor_generation = x11_monitor_generation,
+    .has_motion_events = x11_has_motion_events,
+    .wait_motion = x11_wait_motion,
+    .set_raw_input = x11_set_raw_input,
+    .consume_raw_delta = x11_consume_raw_delta,
+};
@@ -1,6 +1,7 @@
 #include "dr_cursor_tracker.h"
-#include <windows.h>
 #include <util/platform.h>
+#include <util/profiler.h>
+#include <callback/proc.h>
 #include <graphics/graphics.h>
 #include <string.h>
 #include <stdio.h>
@@ -8,67 +9,39 @@
 #include <graphics/image-file.h>
 #include <math.h>
 
-// forward declarations for local texture creators
-static gs_texture_t *create_solid_circle_texture(int radius, uint32_t color, float alpha);
-static gs_texture_t *create_white_circle_texture(int radius);
-
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
 #endif
 
 #define BLOG_PREFIX "[crosshair_box] "
 
-// 內建 Tint Effect（當 Default/Draw 無法設定顏色時的後備方案）
-static const char *g_tint_effect_src =
-    "uniform texture2d image;\n"
-    "uniform float4 color;\n"
-    "sampler_state texSampler { Filter = Linear; AddressU = Clamp; AddressV = Clamp; };\n"
-    "struct VertIn { float4 pos : POSITION; float2 uv : TEXCOORD0; };\n"
-    "struct VertOut { float4 pos : POSITION; float2 uv : TEXCOORD0; };\n"
-    "VertOut VS(VertIn v) { VertOut o; o.pos = v.pos; o.uv = v.uv; return o; }\n"
-    "float4 PS(VertOut v) : TARGET { float4 c = image.Sample(texSampler, v.uv); return c * color; }\n"
-    "technique DrawTint { pass { vertex_shader = VS(v); pixel_shader = PS(v); } }\n";
-static gs_effect_t *g_tint_effect = NULL;
-static gs_eparam_t *g_tint_image_param = NULL;
-static gs_eparam_t *g_tint_color_param = NULL;
-
-// 創建PNG紋理的輔助函數
-static gs_texture_t *create_crosshair_texture(const char *path)
-{
-    if (!path || strlen(path) == 0) {
-        blog(LOG_WARNING, BLOG_PREFIX "路徑為空或無效");
-        return NULL;
-    }
-    
-    // 使用 gs_image_file4_t 載入圖片（使用直接Alpha通道）
-    gs_image_file4_t image4;
-    gs_image_file4_init(&image4, path, GS_IMAGE_ALPHA_STRAIGHT);
-    
-    if (!image4.image3.image2.image.loaded) {
-        blog(LOG_WARNING, BLOG_PREFIX "無法載入圖片: %s", path);
-        gs_image_file4_free(&image4);
-        return NULL;
-    }
-    
-    // 在圖形上下文中初始化紋理
-    obs_enter_graphics();
-    gs_image_file4_init_texture(&image4);
-    obs_leave_graphics();
-    
-    if (!image4.image3.image2.image.texture) {
-        blog(LOG_WARNING, BLOG_PREFIX "無法初始化紋理");
-        gs_image_file4_free(&image4);
-        return NULL;
-    }
-    
-    /* 成功載入圖片：不輸出資訊日誌以降低噪音 */
-    
-    // 複製紋理以避免被銷毀
-    gs_texture_t *texture = image4.image3.image2.image.texture;
-    image4.image3.image2.image.texture = NULL; // 防止被 gs_image_file4_free 銷毀
-    gs_image_file4_free(&image4);
-    return texture;
-}
+// 效能分析區段名稱（profiler 以字串指標區分區段，開始與結束需使用同一個字串）
+static const char *tick_name = "crosshair_box_tick";
+static const char *input_sampling_name = "input sampling";
+static const char *texture_rebuilds_name = "texture rebuilds";
+static const char *path_maintenance_name = "path maintenance";
+static const char *physics_name = "physics";
+static const char *render_name = "crosshair_box_render";
+static const char *static_layer_name = "static layer";
+static const char *tracking_line_layer_name = "tracking line layer";
+static const char *circle_layer_name = "circle layer";
+static const char *crosshair_layer_name = "crosshair layer";
+static const char *image_layer_name = "image layer";
+static const char *box_layer_name = "box layer";
+static const char *batch_upload_name = "batch upload";
+static const char *batch_draw_name = "batch draw";
+static const char *stats_overlay_name = "stats overlay";
+
+// 統計覆蓋層使用的文字來源與字型
+#ifdef _WIN32
+#define STATS_OVERLAY_SOURCE_ID "text_gdiplus"
+#define STATS_OVERLAY_FONT "Consolas"
+#else
+#define STATS_OVERLAY_SOURCE_ID "text_ft2_source"
+#define STATS_OVERLAY_FONT "Monospace"
+#endif
+#define STATS_OVERLAY_FONT_SIZE 20
+#define STATS_OVERLAY_MARGIN 8.0f
 
 static const char *crosshair_box_get_name(void *unused)
 {
@@ -76,20 +49,6 @@ static const char *crosshair_box_get_name(void *unused)
     return obs_module_text("CrosshairTracker");
 }
 
-// 添加顏色轉換函數
-static uint32_t obs_color_to_uint32(uint32_t obs_color)
-{
-    // OBS 顏色格式: RGBA
-    // 我們需要轉換為 ARGB 格式
-    uint8_t r = (obs_color >> 0) & 0xFF;
-    uint8_t g = (obs_color >> 8) & 0xFF;
-    uint8_t b = (obs_color >> 16) & 0xFF;
-    uint8_t a = (obs_color >> 24) & 0xFF;
-    
-    // 轉換為 ARGB 格式
-    return (a << 24) | (r << 16) | (g << 8) | b;
-}
-
 static uint32_t uint32_to_obs_color(uint32_t color)
 {
     // ARGB 格式轉換為 RGBA 格式
@@ -102,112 +61,106 @@ static uint32_t uint32_to_obs_color(uint32_t color)
     return (r << 0) | (g << 8) | (b << 16) | (a << 24);
 }
 
-static void *crosshair_box_create(obs_data_t *settings, obs_source_t *source)
+// 釋放動畫並記錄快取統計；不可在圖形上下文中呼叫（見 anim_image_destroy）
+static void crosshair_release_anim_image(struct dr_cursor_tracker_data *d)
 {
-    struct dr_cursor_tracker_data *data = bzalloc(sizeof(struct dr_cursor_tracker_data));
-    data->mode = (enum crosshair_mode)obs_data_get_int(settings, "crosshair_mode");
-    data->box_size = (int)obs_data_get_int(settings, "box_size");
-    
-    // 如果尚未建立後備效果，嘗試建立一次
-    if (!g_tint_effect) {
-        obs_enter_graphics();
-        g_tint_effect = gs_effect_create(g_tint_effect_src, "DRTintEffect", NULL);
-        if (g_tint_effect) {
-            g_tint_image_param = gs_effect_get_param_by_name(g_tint_effect, "image");
-            g_tint_color_param = gs_effect_get_param_by_name(g_tint_effect, "color");
-        } else {
-            /* 後備效果初始化失敗，僅記憶體內處理，無需日誌 */
-        }
-        obs_leave_graphics();
+    if (!d->anim_image) return;
+    struct anim_image_stats stats;
+    anim_image_get_stats(d->anim_image, &stats);
+    uint64_t shown = stats.hits + stats.misses;
+    if (stats.frame_count) {
+        blog(LOG_INFO, BLOG_PREFIX "動畫圖片統計：%zu 格，%s，佔用 %.1f / %.1f MB，預先解碼命中率 %.1f%%",
+             stats.frame_count, stats.streamed ? "串流" : "常駐", (double)stats.bytes / (1024.0 * 1024.0),
+             (double)stats.budget / (1024.0 * 1024.0), shown ? (double)stats.hits * 100.0 / (double)shown : 100.0);
     }
-    
-    // 使用正確的顏色轉換
-    uint32_t obs_box_color = (uint32_t)obs_data_get_int(settings, "box_color");
-    data->box_color = obs_color_to_uint32(obs_box_color);
-    
-    data->box_thickness = (int)obs_data_get_int(settings, "box_thickness");
-    {
-        bool show_box_init = obs_data_get_bool(settings, "show_box");
-        double box_alpha_val = obs_data_get_double(settings, "box_alpha");
-        data->box_alpha = show_box_init ? (float)box_alpha_val : 0.0f;
+    anim_image_destroy(d->anim_image);
+    d->anim_image = NULL;
+}
+
+// 依變更的資源重建；需要圖形執行緒的部分（緩衝區容量、檔案監看）留給下一次 tick
+static void crosshair_apply_settings(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                     uint32_t dirty)
+{
+    if (dirty & CROSSHAIR_DIRTY_SAMPLER) {
+        shared_sampler_update(d->sampler_client, s->input_sample_rate, s->use_raw_input && s->mode == MODE_MOVEMENT);
     }
-    data->show_default_crosshair = obs_data_get_bool(settings, "show_default_crosshair");
-    
-    // 使用正確的顏色轉換
-    uint32_t obs_crosshair_color = (uint32_t)obs_data_get_int(settings, "crosshair_color");
-    data->crosshair_color = obs_color_to_uint32(obs_crosshair_color);
-    
-    data->crosshair_thickness = (int)obs_data_get_int(settings, "crosshair_thickness");
-    data->crosshair_alpha = (float)obs_data_get_double(settings, "crosshair_alpha");
-    data->crosshair_size = (int)obs_data_get_int(settings, "crosshair_size");
+    // 新圖片在背景解碼，完成前繼續顯示舊圖片
+    if ((dirty & CROSSHAIR_DIRTY_IMAGE) && s->show_image) {
+        texture_slot_request_image(&d->custom_image, s->crosshair_path, s->image_scale);
+        crosshair_stats_add_rebuild(&d->stats);
+    }
+    // 圓形紋理只有批次繪製效果無法使用時才需要，參數變更時在背景重新點陣化
+    if ((dirty & CROSSHAIR_DIRTY_CIRCLE) && !effect_manager_get(CROSSHAIR_EFFECT_BATCH) && !s->show_default_crosshair &&
+        s->circle_alpha > 0.0f && s->circle_thickness > 0) {
+        texture_slot_request_circle(&d->circle_texture, s->circle_radius, s->circle_thickness, s->circle_color,
+                                    s->circle_alpha);
+        crosshair_stats_add_rebuild(&d->stats);
+    }
+    if (dirty & CROSSHAIR_DIRTY_STATIC_LAYER) os_atomic_inc_long(&d->settings_generation);
+
+    // 與 tick 的取出競爭，以 compare-swap 合併
+    long bits = (long)(dirty & (CROSSHAIR_DIRTY_PATH | CROSSHAIR_DIRTY_IMAGE));
+    long pending = os_atomic_load_long(&d->pending_dirty);
+    while (bits && !os_atomic_compare_swap_long(&d->pending_dirty, pending, pending | bits)) {
+        pending = os_atomic_load_long(&d->pending_dirty);
+    }
+}
+
+// proc handler：最後一次發佈的統計
+static void crosshair_proc_get_stats(void *data, calldata_t *cd)
+{
+    struct dr_cursor_tracker_data *d = data;
+    struct crosshair_stats_snapshot snapshot;
+    crosshair_stats_get(&d->stats, &snapshot);
+    calldata_set_int(cd, "live_points", snapshot.live_points);
+    calldata_set_float(cd, "draw_calls", snapshot.draw_calls);
+    calldata_set_int(cd, "texture_bytes", snapshot.texture_bytes);
+    calldata_set_float(cd, "rebuilds_per_second", snapshot.rebuilds_per_second);
+    calldata_set_float(cd, "tick_ms", snapshot.tick_ms);
+    calldata_set_float(cd, "render_ms", snapshot.render_ms);
+    calldata_set_float(cd, "ribbon_reduction", snapshot.ribbon_reduction);
+}
+
+static void *crosshair_box_create(obs_data_t *settings, obs_source_t *source)
+{
+    struct dr_cursor_tracker_data *data = bzalloc(sizeof(struct dr_cursor_tracker_data));
     
-    // 圓圈設定
-    uint32_t obs_circle_color = (uint32_t)obs_data_get_int(settings, "circle_color");
-    data->circle_color = obs_color_to_uint32(obs_circle_color);
-    data->circle_thickness = (int)obs_data_get_int(settings, "circle_thickness");
-    data->circle_alpha = (float)obs_data_get_double(settings, "circle_alpha");
-    data->circle_radius = (int)obs_data_get_int(settings, "circle_radius");
+    // 共用效果已在模組載入時編譯；當時圖形子系統尚未啟動的話在這裡補編譯
+    effect_manager_ensure();
     
-    data->recenter_speed_center = (float)obs_data_get_double(settings, "recenter_speed_center");
-    data->recenter_speed_edge = (float)obs_data_get_double(settings, "recenter_speed_edge");
-    data->crosshair_move_speed_center = (float)obs_data_get_double(settings, "crosshair_move_speed_center");
-    data->crosshair_move_speed_edge = (float)obs_data_get_double(settings, "crosshair_move_speed_edge");
-    data->sensitivity = (float)obs_data_get_double(settings, "sensitivity");
-    data->max_offset = (int)obs_data_get_int(settings, "max_offset");
-    data->enable_idle_recenter = obs_data_get_bool(settings, "enable_idle_recenter");
-    data->idle_recenter_delay = (float)obs_data_get_double(settings, "idle_recenter_delay");
-    data->idle_recenter_time = (float)obs_data_get_double(settings, "idle_recenter_time");
-    data->idle_recenter_boost = (float)obs_data_get_double(settings, "idle_recenter_boost");
-    data->current_idle_time = 0.0f;
-    data->current_recenter_speed = data->recenter_speed_center;
-    data->is_mouse_moving = false;
-    data->crosshair_path = bstrdup(obs_data_get_string(settings, "crosshair_path"));
+    struct crosshair_settings *s = crosshair_settings_create(settings);
+    crosshair_settings_buffer_init(&data->settings, s);
     data->offset_x = 0.0f;
     data->offset_y = 0.0f;
     data->last_mouse_x = 0;
     data->last_mouse_y = 0;
     data->last_update_time = os_gettime_ns();
+    data->has_last_sample = false;
+    motion_init(&data->motion, 0.0f, 0.0f);
+    data->sampler_client = shared_sampler_acquire(s->input_sample_rate,
+                                                  s->use_raw_input && s->mode == MODE_MOVEMENT);
     data->source = source; // 保存源指針
+    crosshair_stats_init(&data->stats, data->last_update_time);
     
     // 初始化圓形紋理
-    data->circle_texture = NULL;
-    data->circle_texture_size = 0;
-    data->circle_texture_color = 0;
-    data->circle_texture_thickness = 0;
-    data->circle_texture_alpha = 0.0f;
-    
-    // 初始化追蹤線設定
-    data->show_tracking_line = obs_data_get_bool(settings, "show_tracking_line");
-    data->tracking_line_mode = (enum tracking_line_mode)obs_data_get_int(settings, "tracking_line_mode");
-    data->tracking_line_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "tracking_line_color"));
-    data->tracking_line_thickness = (int)obs_data_get_int(settings, "tracking_line_thickness");
-    data->tracking_line_alpha = (float)obs_data_get_double(settings, "tracking_line_alpha");
+    texture_slot_init(&data->circle_texture);
     
-    // 初始化路徑追蹤設定
-    data->path_circle_radius = (float)obs_data_get_int(settings, "path_circle_radius");
-    data->path_lifetime = (float)obs_data_get_double(settings, "path_lifetime");
-    data->path_generation_interval = (float)obs_data_get_double(settings, "path_generation_interval");
-    data->path_circle_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "path_circle_color"));
-    data->path_head = NULL;
-    data->path_tail = NULL;
-    data->path_point_count = 0;
-    data->path_circle_texture = NULL;
-    data->path_circle_texture_size = 0;
-    data->path_circle_texture_thickness = 0;
-    data->path_circle_texture_alpha = 0.0f;
+    // 初始化路徑點與緞帶緩衝區
+    path_buffer_init(&data->path_points, s->path_max_points);
     data->last_path_time = 0;
-    data->path_generation_interval = 20.0f; // 距離間隔：20像素
-
-    // 初始化預生成 alpha 紋理快取
-    for (int i = 0; i < 21; ++i) data->path_alpha_textures[i] = NULL;
-    data->path_alpha_texture_count = 21;
-    data->path_alpha_radius_cache = -1;
-    data->path_alpha_thickness_cache = -1;
-    data->path_alpha_color_cache = 0;
+    ribbon_init(&data->ribbon, s->path_max_points);
+    draw_batch_init(&data->batch);
     
-    // 初始化自訂圖片紋理
-    data->custom_image_texture = NULL;
-    data->custom_image_texture_size = 0;
+    // 初始化自訂圖片紋理，第一次套用設定時建立所有資源（取樣執行緒已在上面取得）
+    texture_slot_init(&data->custom_image);
+    crosshair_apply_settings(data, s, CROSSHAIR_DIRTY_ALL & ~CROSSHAIR_DIRTY_SAMPLER);
+    
+    proc_handler_t *ph = obs_source_get_proc_handler(source);
+    proc_handler_add(ph,
+                     "void get_stats(out int live_points, out float draw_calls, out int texture_bytes, "
+                     "out float rebuilds_per_second, out float tick_ms, out float render_ms, "
+                     "out float ribbon_reduction)",
+                     crosshair_proc_get_stats, data);
     
     return data;
 }
@@ -215,50 +168,41 @@ static void *crosshair_box_create(obs_data_t *settings, obs_source_t *source)
 static void crosshair_box_destroy(void *data)
 {
     struct dr_cursor_tracker_data *d = data;
-    if (d->crosshair_path) {
-        bfree(d->crosshair_path);
-        d->crosshair_path = NULL;
-    }
-    if (d->circle_texture) {
-        gs_texture_destroy(d->circle_texture);
-        d->circle_texture = NULL;
-    }
-    if (d->custom_image_texture) {
-        gs_texture_destroy(d->custom_image_texture);
-        d->custom_image_texture = NULL;
-    }
-    if (d->path_circle_texture) {
-        gs_texture_destroy(d->path_circle_texture);
-        d->path_circle_texture = NULL;
-    }
-    // 釋放預生成 alpha 紋理
-    for (int i = 0; i < d->path_alpha_texture_count; ++i) {
-        if (d->path_alpha_textures[i]) {
-            gs_texture_destroy(d->path_alpha_textures[i]);
-            d->path_alpha_textures[i] = NULL;
-        }
+    // 最後一個實例釋放時才會停止共用的取樣執行緒
+    shared_sampler_release(d->sampler_client);
+    d->sampler_client = NULL;
+    file_watcher_destroy(d->image_watcher);
+    d->image_watcher = NULL;
+    bfree(d->watched_image_path);
+    d->watched_image_path = NULL;
+    obs_source_release(d->stats_overlay);
+    d->stats_overlay = NULL;
+    crosshair_release_anim_image(d);
+    obs_enter_graphics();
+    texture_slot_free(&d->circle_texture);
+    texture_slot_free(&d->custom_image);
+    draw_batch_free(&d->batch);
+    if (d->static_layer) {
+        gs_texrender_destroy(d->static_layer);
+        d->static_layer = NULL;
     }
-    
-    // 嘗試釋放後備 tint effect（僅在存在時）
-    if (g_tint_effect) {
-        obs_enter_graphics();
-        gs_effect_destroy(g_tint_effect);
-        g_tint_effect = NULL;
-        g_tint_image_param = NULL;
-        g_tint_color_param = NULL;
-        obs_leave_graphics();
+    obs_leave_graphics();
+    if (d->rendered_frames > 0) {
+        blog(LOG_INFO, BLOG_PREFIX "平均每幀 %.2f 次繪製呼叫（%llu 幀，靜態畫面快取命中 %.1f%%）",
+             (double)d->total_draw_calls / (double)d->rendered_frames, (unsigned long long)d->rendered_frames,
+             (double)d->static_layer_hits * 100.0 / (double)d->rendered_frames);
     }
     
-    // 清理路徑點鏈表
-    struct path_point *current = d->path_head;
-    while (current) {
-        struct path_point *next = current->next;
-        bfree(current);
-        current = next;
-    }
-    d->path_head = NULL;
-    d->path_tail = NULL;
-    d->path_point_count = 0;
+    // 釋放路徑點緩衝區
+    path_buffer_free(&d->path_points);
+    if (d->ribbon.total_samples > 0) {
+        blog(LOG_INFO, BLOG_PREFIX "緞帶軌跡簡化：%llu 個取樣點移除 %llu 個（%.1f%%）",
+             (unsigned long long)d->ribbon.total_samples, (unsigned long long)d->ribbon.removed_samples,
+             ribbon_reduction_ratio(&d->ribbon) * 100.0f);
+    }
+    ribbon_free(&d->ribbon);
+    crosshair_settings_buffer_free(&d->settings);
+    crosshair_stats_free(&d->stats);
     
     bfree(data);
 }
@@ -266,310 +210,364 @@ static void crosshair_box_destroy(void *data)
 static void crosshair_box_update(void *data, obs_data_t *settings)
 {
     struct dr_cursor_tracker_data *d = data;
-    d->mode = (enum crosshair_mode)obs_data_get_int(settings, "crosshair_mode");
-    d->box_size = (int)obs_data_get_int(settings, "box_size");
-    
-    // 使用正確的顏色轉換
-    uint32_t obs_box_color = (uint32_t)obs_data_get_int(settings, "box_color");
-    d->box_color = obs_color_to_uint32(obs_box_color);
-    
-    d->box_thickness = (int)obs_data_get_int(settings, "box_thickness");
-    {
-        bool show_box_upd = obs_data_get_bool(settings, "show_box");
-        double box_alpha_val = obs_data_get_double(settings, "box_alpha");
-        d->box_alpha = show_box_upd ? (float)box_alpha_val : 0.0f;
+    struct crosshair_settings *next = crosshair_settings_create(settings);
+    // 發佈後 tick / render 下一次取得快照時才會看到新設定，正在使用舊快照的讀取者不受影響
+    crosshair_settings_lock(&d->settings);
+    uint32_t dirty = crosshair_settings_publish(&d->settings, next);
+    crosshair_apply_settings(d, next, dirty);
+    crosshair_settings_unlock(&d->settings);
+}
+
+// 移動模式：由目前設定建立積分器參數
+static void crosshair_motion_params(const struct crosshair_settings *s, struct motion_params *params)
+{
+    params->sensitivity = s->sensitivity;
+    params->move_speed_center = s->crosshair_move_speed_center;
+    params->move_speed_edge = s->crosshair_move_speed_edge;
+    params->recenter_speed_center = s->recenter_speed_center;
+    params->recenter_speed_edge = s->recenter_speed_edge;
+    params->max_offset = (float)s->max_offset;
+    params->idle_recenter = s->enable_idle_recenter;
+    params->idle_delay = s->idle_recenter_delay;
+    params->idle_ramp = s->idle_recenter_time;
+    params->idle_boost = s->idle_recenter_boost;
+    params->move_curve = &s->move_speed_curve;
+    params->recenter_curve = &s->recenter_curve;
+    params->idle_curve = &s->idle_boost_curve;
+}
+
+// 座標模式：直接映射滑鼠位置到方框內
+static void crosshair_coordinate_map(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                     const struct cursor_sample *sample)
+{
+    // 從螢幕快取取得映射範圍（滑鼠所在螢幕、指定螢幕或整個虛擬桌面）
+    struct cursor_rect rect;
+    if (!monitor_cache_resolve(shared_sampler_monitors(), s->coordinate_monitor, sample->x, sample->y, &rect)) return;
+    if (rect.right <= rect.left || rect.bottom <= rect.top) return;
+
+    // 計算滑鼠在當前螢幕中的相對位置（0.0 - 1.0）
+    float relative_x = (float)(sample->x - rect.left) /
+                     (float)(rect.right - rect.left);
+    float relative_y = (float)(sample->y - rect.top) /
+                     (float)(rect.bottom - rect.top);
+    // 指定螢幕時滑鼠可能在範圍外
+    relative_x = relative_x < 0.0f ? 0.0f : (relative_x > 1.0f ? 1.0f : relative_x);
+    relative_y = relative_y < 0.0f ? 0.0f : (relative_y > 1.0f ? 1.0f : relative_y);
+
+    // 將相對位置映射到方框範圍內
+    d->offset_x = ((relative_x * 2.0f) - 1.0f) * s->max_offset;
+    d->offset_y = ((relative_y * 2.0f) - 1.0f) * s->max_offset;
+}
+
+// ARGB 顏色轉為頂點顏色（GS_RGBA 位元組順序，alpha 另外填入）
+static inline uint32_t argb_to_vertex_rgb(uint32_t color)
+{
+    uint32_t r = (color >> 16) & 0xFF;
+    uint32_t g = (color >> 8) & 0xFF;
+    uint32_t b = color & 0xFF;
+    return r | (g << 8) | (b << 16);
+}
+
+// 緞帶的繪製樣式
+static void crosshair_ribbon_style(const struct crosshair_settings *s, struct ribbon_style *style)
+{
+    style->width = s->ribbon_width;
+    style->full_speed = s->ribbon_full_speed;
+    style->lifetime_ns = (uint64_t)(s->path_lifetime * 1000000000.0f);
+    style->rgb = argb_to_vertex_rgb(s->ribbon_color);
+}
+
+// 路徑 / 緞帶模式：依準心中心與最後一點的距離新增路徑點
+static void crosshair_path_sample(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                  float center_x, float center_y, uint64_t timestamp)
+{
+    bool ribbon_mode = s->tracking_line_mode == TRACKING_MODE_RIBBON;
+
+    // 計算是否應生成新點（以準心中心距離為準）
+    bool should_generate = false;
+    float last_x, last_y;
+    bool has_last = ribbon_mode ? ribbon_last_point(&d->ribbon, &last_x, &last_y)
+                                : path_buffer_last(&d->path_points, &last_x, &last_y);
+    if (!has_last) {
+        should_generate = true;
+    } else {
+        float distance_to_last = sqrtf(
+            (center_x - last_x) * (center_x - last_x) +
+            (center_y - last_y) * (center_y - last_y));
+        if (distance_to_last >= s->path_generation_interval) should_generate = true;
     }
-    d->show_default_crosshair = obs_data_get_bool(settings, "show_default_crosshair");
-    
-    // 使用正確的顏色轉換
-    uint32_t obs_crosshair_color = (uint32_t)obs_data_get_int(settings, "crosshair_color");
-    d->crosshair_color = obs_color_to_uint32(obs_crosshair_color);
-    
-    d->crosshair_thickness = (int)obs_data_get_int(settings, "crosshair_thickness");
-    d->crosshair_alpha = (float)obs_data_get_double(settings, "crosshair_alpha");
-    d->crosshair_size = (int)obs_data_get_int(settings, "crosshair_size");
-    
 
-    
-    // 圓圈設定
-    uint32_t obs_circle_color = (uint32_t)obs_data_get_int(settings, "circle_color");
-    d->circle_color = obs_color_to_uint32(obs_circle_color);
-    d->circle_thickness = (int)obs_data_get_int(settings, "circle_thickness");
-    d->circle_alpha = (float)obs_data_get_double(settings, "circle_alpha");
-    d->circle_radius = (int)obs_data_get_int(settings, "circle_radius");
-    
-    // 更新追蹤線設定
-    d->show_tracking_line = obs_data_get_bool(settings, "show_tracking_line");
-    d->tracking_line_mode = (enum tracking_line_mode)obs_data_get_int(settings, "tracking_line_mode");
-    d->tracking_line_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "tracking_line_color"));
-    d->tracking_line_thickness = (int)obs_data_get_int(settings, "tracking_line_thickness");
-    d->tracking_line_alpha = (float)obs_data_get_double(settings, "tracking_line_alpha");
-    
-    // 更新路徑追蹤設定
-    d->path_circle_radius = (float)obs_data_get_int(settings, "path_circle_radius");
-    d->path_lifetime = (float)obs_data_get_double(settings, "path_lifetime");
-    d->path_generation_interval = (float)obs_data_get_double(settings, "path_generation_interval");
-    d->path_circle_color = obs_color_to_uint32((uint32_t)obs_data_get_int(settings, "path_circle_color"));
-
-    // 若半徑或顏色改變，重建預生成 alpha 紋理
-    if (d->path_alpha_radius_cache != (int)d->path_circle_radius ||
-        d->path_alpha_color_cache != d->path_circle_color) {
-        for (int i = 0; i < d->path_alpha_texture_count; ++i) {
-            if (d->path_alpha_textures[i]) {
-                gs_texture_destroy(d->path_alpha_textures[i]);
-                d->path_alpha_textures[i] = NULL;
-            }
-        }
-        obs_enter_graphics();
-        for (int i = 0; i < d->path_alpha_texture_count; ++i) {
-            float alpha = (float)(i * 5) / 100.0f;
-            d->path_alpha_textures[i] = create_solid_circle_texture((int)d->path_circle_radius, d->path_circle_color, alpha);
+    // 緩衝區已滿時會覆寫最舊的點，不再需要額外的上限判斷
+    if (should_generate) {
+        if (ribbon_mode) {
+            ribbon_add_point(&d->ribbon, center_x, center_y, timestamp);
+        } else {
+            path_buffer_push(&d->path_points, center_x, center_y, timestamp);
         }
-        obs_leave_graphics();
-        d->path_alpha_radius_cache = (int)d->path_circle_radius;
-        d->path_alpha_color_cache = d->path_circle_color;
     }
-    
-    d->recenter_speed_center = (float)obs_data_get_double(settings, "recenter_speed_center");
-    d->recenter_speed_edge = (float)obs_data_get_double(settings, "recenter_speed_edge");
-    d->crosshair_move_speed_center = (float)obs_data_get_double(settings, "crosshair_move_speed_center");
-    d->crosshair_move_speed_edge = (float)obs_data_get_double(settings, "crosshair_move_speed_edge");
-    d->sensitivity = (float)obs_data_get_double(settings, "sensitivity");
-    d->max_offset = (int)obs_data_get_int(settings, "max_offset");
-    
-    // 靜止回彈加速設定
-    d->enable_idle_recenter = obs_data_get_bool(settings, "enable_idle_recenter");
-    d->idle_recenter_delay = (float)obs_data_get_double(settings, "idle_recenter_delay");
-    d->idle_recenter_time = (float)obs_data_get_double(settings, "idle_recenter_time");
-    d->idle_recenter_boost = (float)obs_data_get_double(settings, "idle_recenter_boost");
-    
+}
 
-    
-    const char *new_path = obs_data_get_string(settings, "crosshair_path");
-    if (d->crosshair_path && (!new_path || strcmp(d->crosshair_path, new_path) != 0)) {
-        bfree(d->crosshair_path);
-        d->crosshair_path = new_path ? bstrdup(new_path) : NULL;
-        
-        // 強制重新創建紋理
-        if (d->custom_image_texture) {
-            gs_texture_destroy(d->custom_image_texture);
-            d->custom_image_texture = NULL;
-            d->custom_image_texture_size = 0;
-        }
+// 依目前監看的路徑重新建立動畫
+static void crosshair_reload_anim_image(struct dr_cursor_tracker_data *d)
+{
+    crosshair_release_anim_image(d);
+    d->anim_image = anim_image_create(d->watched_image_path, d->watched_image_sequence);
+}
+
+// 自訂圖片第一次解碼期間顯示的佔位圓環半徑（像素）
+#define IMAGE_PLACEHOLDER_RADIUS 8.0f
+// 後備繪製的路徑點以幾邊形近似
+#define FALLBACK_DOT_SEGMENTS 16
+
+// 自訂圖片檔案變更後等待寫入完成的時間：編輯器存檔常會連續觸發多個事件
+#define IMAGE_RELOAD_DELAY_NS 200000000ULL
+
+// 監看目前的自訂圖片：路徑變更時重建監看，檔案變更且靜止一段時間後重新請求
+// 紋理快取的鍵包含檔案的修改時間，所以重新請求會產生新的解碼工作，完成前繼續顯示舊圖片
+// 動畫則整個重新載入，載入期間由靜態紋理顯示第一格
+static void crosshair_watch_image(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                  uint64_t now_ns, bool image_dirty)
+{
+    const char *path = s->show_image ? s->crosshair_path : NULL;
+
+    // 圖片設定變更時才比對路徑；只改縮放時沿用原本的監看與動畫
+    bool same = !image_dirty || (path ? (d->watched_image_path && strcmp(path, d->watched_image_path) == 0)
+                                      : !d->watched_image_path);
+    if (!same) {
+        file_watcher_destroy(d->image_watcher);
+        bfree(d->watched_image_path);
+        d->watched_image_path = path ? bstrdup(path) : NULL;
+        d->image_watcher = path ? file_watcher_create(path) : NULL;
+        d->image_changed_time = 0;
+        d->watched_image_sequence = s->play_image_sequence;
+        crosshair_reload_anim_image(d);
+    } else if (image_dirty && d->watched_image_sequence != s->play_image_sequence) {
+        // 只切換圖片序列播放時沿用檔案監看，重新建立動畫
+        d->watched_image_sequence = s->play_image_sequence;
+        crosshair_reload_anim_image(d);
     }
+
+    if (file_watcher_poll(d->image_watcher)) d->image_changed_time = now_ns;
+    if (d->image_changed_time && now_ns - d->image_changed_time >= IMAGE_RELOAD_DELAY_NS) {
+        d->image_changed_time = 0;
+        blog(LOG_INFO, BLOG_PREFIX "圖片已變更，重新載入: %s", d->watched_image_path);
+        texture_slot_request_image(&d->custom_image, d->watched_image_path, s->image_scale);
+        crosshair_reload_anim_image(d);
+        os_atomic_inc_long(&d->settings_generation);
+        crosshair_stats_add_rebuild(&d->stats);
+    }
+
+    if (d->anim_image) anim_image_tick(d->anim_image, now_ns, s->image_sequence_fps);
 }
 
-// 恢復滑鼠追蹤和回彈功能
-// 用於保存螢幕資訊的結構
-struct monitor_info {
-    POINT pt;
-    RECT rect;
-};
+// 建立顯示統計的私有文字來源；失敗時回傳 NULL
+static obs_source_t *crosshair_create_stats_overlay(void)
+{
+    const char *id = obs_get_latest_input_type_id(STATS_OVERLAY_SOURCE_ID);
+    if (!id) id = STATS_OVERLAY_SOURCE_ID;
+
+    obs_data_t *settings = obs_data_create();
+    obs_data_t *font = obs_data_create();
+    obs_data_set_string(font, "face", STATS_OVERLAY_FONT);
+    obs_data_set_int(font, "size", STATS_OVERLAY_FONT_SIZE);
+    obs_data_set_obj(settings, "font", font);
+    obs_data_set_bool(settings, "outline", true);
+    obs_source_t *overlay = obs_source_create_private(id, "crosshair_box_stats", settings);
+    obs_data_release(font);
+    obs_data_release(settings);
+
+    if (!overlay) blog(LOG_WARNING, BLOG_PREFIX "無法建立統計覆蓋層的文字來源 %s", id);
+    return overlay;
+}
 
-// 獲取滑鼠所在螢幕的資訊
-static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData)
+// 依設定建立 / 釋放覆蓋層，區間結束時發佈統計並更新覆蓋層文字
+static void crosshair_update_stats(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                   uint64_t now_ns)
 {
-    struct monitor_info *info = (struct monitor_info *)dwData;
-    if (info->pt.x >= lprcMonitor->left && info->pt.x < lprcMonitor->right &&
-        info->pt.y >= lprcMonitor->top && info->pt.y < lprcMonitor->bottom) {
-        // 找到滑鼠所在的螢幕，保存其座標範圍
-        info->rect = *lprcMonitor;
-        return FALSE; // 停止枚舉
-    }
-    return TRUE; // 繼續枚舉
+    bool overlay_changed = false;
+    if (s->show_stats_overlay && !d->stats_overlay && !d->stats_overlay_failed) {
+        d->stats_overlay = crosshair_create_stats_overlay();
+        d->stats_overlay_failed = !d->stats_overlay;
+        overlay_changed = d->stats_overlay != NULL;
+    } else if (!s->show_stats_overlay) {
+        obs_source_release(d->stats_overlay);
+        d->stats_overlay = NULL;
+        d->stats_overlay_failed = false;
+    }
+
+    bool published = crosshair_stats_due(&d->stats, now_ns);
+    if (published) {
+        long long live_points = 0;
+        if (s->show_tracking_line && s->tracking_line_mode == TRACKING_MODE_PATH) {
+            live_points = d->path_points.count;
+        } else if (s->show_tracking_line && s->tracking_line_mode == TRACKING_MODE_RIBBON) {
+            live_points = d->ribbon.count;
+        }
+
+        // 紋理快取由所有來源共用，動畫則是本來源獨有
+        struct texture_cache_stats cache;
+        texture_cache_get_stats(&cache);
+        size_t texture_bytes = cache.bytes;
+        if (d->anim_image) {
+            struct anim_image_stats anim;
+            anim_image_get_stats(d->anim_image, &anim);
+            texture_bytes += anim.bytes;
+        }
+        crosshair_stats_publish(&d->stats, now_ns, live_points, (long long)texture_bytes,
+                                ribbon_reduction_ratio(&d->ribbon));
+    }
+
+    if (d->stats_overlay && (published || overlay_changed)) {
+        struct crosshair_stats_snapshot snapshot;
+        crosshair_stats_get(&d->stats, &snapshot);
+        struct dstr text;
+        dstr_init(&text);
+        crosshair_stats_format(&snapshot, &text);
+
+        obs_data_t *settings = obs_data_create();
+        obs_data_set_string(settings, "text", text.array);
+        obs_source_update(d->stats_overlay, settings);
+        obs_data_release(settings);
+        dstr_free(&text);
+    }
 }
 
 static void crosshair_box_tick(void *data, float seconds)
 {
     struct dr_cursor_tracker_data *d = data;
-    
-    // 取得滑鼠座標
-    POINT pt;
-    if (GetCursorPos(&pt)) {
-        if (d->mode == MODE_MOVEMENT) {
-            // 移動模式：使用相對移動和回彈
-            float dx = (float)pt.x - d->last_mouse_x;
-            float dy = (float)pt.y - d->last_mouse_y;
-            
-            // 計算距離中心的距離用於動態速度
-            float distance_from_center = sqrtf(d->offset_x * d->offset_x + d->offset_y * d->offset_y);
-            float max_distance = (float)d->max_offset;
-            float normalized_distance = (max_distance > 0.0f) ? distance_from_center / max_distance : 0.0f;
-            if (normalized_distance > 1.0f) normalized_distance = 1.0f;
-            
-                    // 檢測滑鼠是否移動
-        if (dx != 0 || dy != 0) {
-            d->is_mouse_moving = true;
-            d->current_idle_time = 0.0f;
-            d->is_mouse_moving = true;
-        } else {
-            d->is_mouse_moving = false;
-            // 只有在靜止時才增加時間
-            if (d->enable_idle_recenter) {
-                d->current_idle_time += seconds;
-            }
+    UNUSED_PARAMETER(seconds); // 時間一律取自樣本時間戳
+
+    profile_start(tick_name);
+    uint64_t tick_start = os_gettime_ns();
+
+    // 整個 tick 使用同一份設定快照，update 在其間發佈的新設定下一次 tick 才生效
+    long settings_slot;
+    const struct crosshair_settings *s = crosshair_settings_acquire(&d->settings, &settings_slot);
+
+    // 本幀的共用樣本快照：第一個 tick 的實例取出樣本，其餘實例直接讀取
+    profile_start(input_sampling_name);
+    const struct sampler_frame *frame = shared_sampler_get_frame();
+    profile_end(input_sampling_name);
+    const struct cursor_sample *samples = frame->samples;
+    size_t sample_count = frame->count;
+    uint64_t now_ns = frame->now_ns;
+
+    // update 留下的資源變更
+    uint32_t dirty = (uint32_t)os_atomic_exchange_long(&d->pending_dirty, 0);
+
+    profile_start(texture_rebuilds_name);
+    crosshair_watch_image(d, s, now_ns, (dirty & CROSSHAIR_DIRTY_IMAGE) != 0);
+    profile_end(texture_rebuilds_name);
+
+    profile_start(path_maintenance_name);
+    // 容量設定變更時在圖形執行緒上調整緩衝區，避免與繪製競爭
+    if (dirty & CROSSHAIR_DIRTY_PATH) {
+        if (d->path_points.capacity != s->path_max_points) {
+            path_buffer_resize(&d->path_points, s->path_max_points);
         }
+        if (d->ribbon.capacity != s->path_max_points * RIBBON_SUBDIVISIONS) {
+            ribbon_resize(&d->ribbon, s->path_max_points);
+        }
+    }
 
-        // 計算基礎速度
-        // 基礎速度 = 中心速度 + (外圍速度 - 中心速度) * 距離
-        float base_speed = d->recenter_speed_center + 
-            (d->recenter_speed_edge - d->recenter_speed_center) * normalized_distance;
-
-        // 初始化加速值
-        float current_boost = 0.0f;
-        float progress = 0.0f;
-
-        // 處理靜止回彈加速
-        if (d->enable_idle_recenter && !d->is_mouse_moving) {
-            // 增加靜止時間
-            d->current_idle_time += seconds;
-
-            // 檢查是否已經超過延遲時間（修正延遲判斷）
-            if (d->idle_recenter_delay == 0.0f || d->current_idle_time >= d->idle_recenter_delay) {
-                // 計算加速進度
-                float acceleration_time = d->current_idle_time - d->idle_recenter_delay;
-                
-                if (d->idle_recenter_time > 0.0f) {
-                    // 計算基本進度
-                    progress = acceleration_time / d->idle_recenter_time;
-                    if (progress > 1.0f) progress = 1.0f;
-                } else {
-                    // 如果加速時間為0，直接使用最大進度
-                    progress = 1.0f;
-                }
-
-                // 加速值 = 目標加速值 * 進度
-                current_boost = d->idle_recenter_boost * progress;
-            } else {
-                // 仍在延遲中
-            }
+    bool path_mode = s->show_tracking_line &&
+                     (s->tracking_line_mode == TRACKING_MODE_PATH || s->tracking_line_mode == TRACKING_MODE_RIBBON);
+    float half_width = 0.0f, half_height = 0.0f;
+    if (path_mode) {
+        uint64_t lifetime_ns = (uint64_t)(s->path_lifetime * 1000000000.0f);
+        if (s->tracking_line_mode == TRACKING_MODE_RIBBON) {
+            ribbon_expire(&d->ribbon, now_ns, lifetime_ns);
         } else {
-            // 移動時重置靜止時間
-            d->current_idle_time = 0.0f;
+            // 先清理過期點：時間戳單調遞增，只需推進 head
+            path_buffer_expire(&d->path_points, now_ns, lifetime_ns);
         }
 
-        // 計算最終速度
-        // 最終速度 = (中心速度 + 加速值) + ((外圍速度 + 加速值) - (中心速度 + 加速值)) * 距離
-        float boosted_center = d->recenter_speed_center + current_boost;
-        float boosted_edge = d->recenter_speed_edge + current_boost;
-        float final_speed = boosted_center + (boosted_edge - boosted_center) * normalized_distance;
-
-        // 確保速度不會小於0
-        if (final_speed < 0.0f) final_speed = 0.0f;
-
-        // 更新當前回彈速度
-        d->current_recenter_speed = final_speed;
+        half_width = (float)obs_source_get_base_width(d->source) / 2.0f;
+        half_height = (float)obs_source_get_base_height(d->source) / 2.0f;
+    }
+    profile_end(path_maintenance_name);
+
+    // 移動（含逐樣本加入路徑點）
+    profile_start(physics_name);
+    // 移動模式以樣本時間戳推進固定步長積分器，與輸出幀率無關；
+    // 偏移量可能已被座標模式改寫，每幀先同步回積分器
+    struct motion_params motion_params;
+    bool movement_mode = s->mode == MODE_MOVEMENT;
+    if (movement_mode) {
+        crosshair_motion_params(s, &motion_params);
+        d->motion.offset_x = d->offset_x;
+        d->motion.offset_y = d->offset_y;
+    } else {
+        d->motion.started = false;
+    }
 
-        // 應用回彈效果
-        if (final_speed > 0.0f) {
-            float recenter_factor = 1.0f - (final_speed * seconds);
-            if (recenter_factor < 0.0f) recenter_factor = 0.0f;
-            d->offset_x *= recenter_factor;
-            d->offset_y *= recenter_factor;
+    // 逐一處理子幀樣本，讓移動與路徑點都以取樣頻率而非幀率計算
+    for (size_t i = 0; i < sample_count; ++i) {
+        const struct cursor_sample *sample = &samples[i];
+        float x = (float)sample->x;
+        float y = (float)sample->y;
+
+        // 第一個樣本只作為基準，避免從 (0,0) 產生巨大位移
+        if (!d->has_last_sample) {
+            d->last_mouse_x = x;
+            d->last_mouse_y = y;
+            d->has_last_sample = true;
         }
-            
-            // 根據滑鼠移動更新偏移量（應用動態速度）
-            d->offset_x += dx * d->sensitivity * d->crosshair_move_speed_center;
-            d->offset_y += dy * d->sensitivity * d->crosshair_move_speed_center;
-            
-            // 限制最大偏移
-            if (d->offset_x > (float)d->max_offset) d->offset_x = (float)d->max_offset;
-            if (d->offset_x < -(float)d->max_offset) d->offset_x = -(float)d->max_offset;
-            if (d->offset_y > (float)d->max_offset) d->offset_y = (float)d->max_offset;
-            if (d->offset_y < -(float)d->max_offset) d->offset_y = -(float)d->max_offset;
-            
-                        // 動態回彈效果 - 根據距離中心的遠近和靜止時間調整回彈速度
-            float distance_ratio = (max_distance > 0.0f) ? distance_from_center / max_distance : 0.0f;
-            if (distance_ratio > 1.0f) distance_ratio = 1.0f;
 
-            // 使用當前回彈速度
-            d->offset_x *= (1.0f - d->current_recenter_speed * seconds);
-            d->offset_y *= (1.0f - d->current_recenter_speed * seconds);
+        // 原始輸入啟用時直接使用裝置的相對位移，不受畫面邊緣與游標鎖定影響
+        bool use_raw = s->use_raw_input && sample->raw;
+        bool mouse_moved = (d->last_mouse_x != x || d->last_mouse_y != y) ||
+                           (use_raw && (sample->raw_dx != 0.0f || sample->raw_dy != 0.0f));
+        if (movement_mode) {
+            float dx = use_raw ? sample->raw_dx : x - d->last_mouse_x;
+            float dy = use_raw ? sample->raw_dy : y - d->last_mouse_y;
+            motion_advance(&d->motion, &motion_params, sample->timestamp);
+            motion_apply_input(&d->motion, &motion_params, dx, dy);
+            d->offset_x = d->motion.offset_x;
+            d->offset_y = d->motion.offset_y;
         } else {
-            // 座標模式：直接映射滑鼠位置到方框內
-            // 更新當前螢幕資訊
-            struct monitor_info info;
-            info.pt = pt;
-            EnumDisplayMonitors(NULL, NULL, MonitorEnumProc, (LPARAM)&info);
-            
-            // 計算滑鼠在當前螢幕中的相對位置（0.0 - 1.0）
-            float relative_x = (float)(pt.x - info.rect.left) / 
-                             (float)(info.rect.right - info.rect.left);
-            float relative_y = (float)(pt.y - info.rect.top) / 
-                             (float)(info.rect.bottom - info.rect.top);
-            
-            // 將相對位置映射到方框範圍內
-            d->offset_x = ((relative_x * 2.0f) - 1.0f) * d->max_offset;
-            d->offset_y = ((relative_y * 2.0f) - 1.0f) * d->max_offset;
+            crosshair_coordinate_map(d, s, sample);
         }
-        
-        // 路徑模式：先清理過期點，再依距離新增點
-        if (d->show_tracking_line && d->tracking_line_mode == TRACKING_MODE_PATH) {
-            // 計算準心中心位置
-            uint32_t width = obs_source_get_base_width(d->source);
-            uint32_t height = obs_source_get_base_height(d->source);
-            float center_x = (float)width / 2.0f + d->offset_x;
-            float center_y = (float)height / 2.0f + d->offset_y;
 
-            // 先清理過期點（避免因尚未清掉而卡在上限）
-            uint64_t lifetime_ns = (uint64_t)(d->path_lifetime * 1000000000.0f);
-            struct path_point *cur = d->path_head;
-            struct path_point *prev = NULL;
-            uint64_t now_ns = os_gettime_ns();
-            while (cur) {
-                uint64_t age = now_ns - cur->timestamp;
-                if (age > lifetime_ns) {
-                    struct path_point *next = cur->next;
-                    if (prev) prev->next = next; else d->path_head = next;
-                    if (cur == d->path_tail) d->path_tail = prev;
-                    bfree(cur);
-                    d->path_point_count--;
-                    cur = next;
-                } else {
-                    prev = cur;
-                    cur = cur->next;
-                }
-            }
-
-            // 檢查滑鼠是否移動
-            bool mouse_moved = (d->last_mouse_x != (float)pt.x || d->last_mouse_y != (float)pt.y);
-            if (mouse_moved) {
-                // 計算是否應生成新點（以準心中心距離為準）
-                bool should_generate = false;
-                if (d->path_head == NULL) {
-                    should_generate = true;
-                } else {
-                    struct path_point *last_point = d->path_tail;
-                    float distance_to_last = sqrtf(
-                        (center_x - last_point->x) * (center_x - last_point->x) +
-                        (center_y - last_point->y) * (center_y - last_point->y));
-                    if (distance_to_last >= d->path_generation_interval) should_generate = true;
-                }
-
-                const int max_points = 1000; // 提高上限，避免因上限造成週期性停頓
-                if (should_generate && d->path_point_count < max_points) {
-                    struct path_point *new_point = bzalloc(sizeof(struct path_point));
-                    new_point->x = center_x;
-                    new_point->y = center_y;
-                    new_point->timestamp = now_ns;
-                    new_point->next = NULL;
-
-                    if (d->path_tail) { d->path_tail->next = new_point; d->path_tail = new_point; }
-                    else { d->path_head = d->path_tail = new_point; }
-                    d->path_point_count++;
-
-                    /* 移除頻繁的點數量除錯日誌 */
-                }
-
-                // 更新最後的滑鼠位置
-                d->last_mouse_x = (float)pt.x;
-                d->last_mouse_y = (float)pt.y;
-            }
+        if (path_mode && mouse_moved) {
+            crosshair_path_sample(d, s, half_width + d->offset_x, half_height + d->offset_y, sample->timestamp);
         }
-        
-        d->last_mouse_x = (float)pt.x;
-        d->last_mouse_y = (float)pt.y;
+
+        d->last_mouse_x = x;
+        d->last_mouse_y = y;
+    }
+
+    // 座標模式在滑鼠靜止時仍以最後位置重新映射，讓偏移設定變更立即生效
+    if (s->mode == MODE_COORDINATE && sample_count == 0 && d->has_last_sample) {
+        struct cursor_sample last = {
+            .x = (int32_t)d->last_mouse_x,
+            .y = (int32_t)d->last_mouse_y,
+            .timestamp = now_ns,
+        };
+        crosshair_coordinate_map(d, s, &last);
     }
+
+    // 最後一個樣本到本幀之間沒有移動，補上這段時間的回彈
+    if (movement_mode && d->has_last_sample) {
+        motion_advance(&d->motion, &motion_params, now_ns);
+        d->offset_x = d->motion.offset_x;
+        d->offset_y = d->motion.offset_y;
+    }
+    profile_end(physics_name);
+
+    // 新鮮區以外的緞帶取樣點逐步簡化，長存活時間下頂點數不會隨點數線性成長
+    if (path_mode && s->tracking_line_mode == TRACKING_MODE_RIBBON) {
+        profile_start(path_maintenance_name);
+        struct ribbon_style style;
+        crosshair_ribbon_style(s, &style);
+        ribbon_simplify(&d->ribbon, &style, now_ns, s->ribbon_simplify_tolerance);
+        profile_end(path_maintenance_name);
+    }
+
+    crosshair_stats_record_tick(&d->stats, os_gettime_ns() - tick_start);
+    crosshair_update_stats(d, s, now_ns);
+    crosshair_settings_release(&d->settings, settings_slot);
+    profile_end(tick_name);
 }
 
 static void set_effect_color(gs_effect_t *effect, uint32_t color, float alpha)
@@ -590,336 +588,410 @@ static void set_effect_color(gs_effect_t *effect, uint32_t color, float alpha)
 
 
 
-// 創建圓形紋理的輔助函數
-
-static inline float clampf(float x, float min_val, float max_val)
+static uint32_t crosshair_box_get_width(void *data)
 {
-    if (x < min_val) return min_val;
-    if (x > max_val) return max_val;
-    return x;
+    struct dr_cursor_tracker_data *d = data;
+    if (!d) return 300;
+    long slot;
+    uint32_t size = (uint32_t)crosshair_settings_acquire(&d->settings, &slot)->box_size;
+    crosshair_settings_release(&d->settings, slot);
+    return size;
 }
 
-static inline float smoothstep(float edge0, float edge1, float x)
+static uint32_t crosshair_box_get_height(void *data)
 {
-    float t = clampf((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
-    return t * t * (3.0f - 2.0f * t);
+    struct dr_cursor_tracker_data *d = data;
+    if (!d) return 300;
+    long slot;
+    uint32_t size = (uint32_t)crosshair_settings_acquire(&d->settings, &slot)->box_size;
+    crosshair_settings_release(&d->settings, slot);
+    return size;
 }
 
-static gs_texture_t *create_circle_texture(int radius, int thickness, uint32_t color, float alpha)
+// ARGB 顏色與透明度轉為頂點顏色
+static inline uint32_t crosshair_vertex_color(uint32_t color, float alpha)
 {
-    int texture_size = (radius + thickness) * 2;
-    uint8_t *data = (uint8_t *)bzalloc(texture_size * texture_size * 4);
-
-    float center = (float)texture_size / 2.0f;
-    float inner_radius = (float)radius;
-    float outer_radius = (float)(radius + thickness);
-    float edge_distance = 1.0f;
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    return argb_to_vertex_rgb(color) | ((uint32_t)(alpha * 255.0f + 0.5f) << 24);
+}
 
-    uint8_t r = (color >> 16) & 0xFF;
-    uint8_t g = (color >> 8) & 0xFF;
-    uint8_t b = color & 0xFF;
-    uint8_t a = (uint8_t)(alpha * 255);
-
-    for (int y = 0; y < texture_size; y++) {
-        for (int x = 0; x < texture_size; x++) {
-            float dx = (float)x - center;
-            float dy = (float)y - center;
-            float distance = sqrtf(dx * dx + dy * dy);
-
-            if (distance >= inner_radius - edge_distance &&
-                distance <= outer_radius + edge_distance) {
-
-                float fade_in  = smoothstep(inner_radius, inner_radius + edge_distance, distance);
-                float fade_out = smoothstep(outer_radius - edge_distance, outer_radius, distance);
-                float alpha_multiplier = fade_in * (1.0f - fade_out);
-
-                size_t index = (y * texture_size + x) * 4;
-                data[index + 0] = r;
-                data[index + 1] = g;
-                data[index + 2] = b;
-                data[index + 3] = (uint8_t)(a * alpha_multiplier);
-            }
+// 目前要顯示的自訂圖片紋理與繪製縮放；沒有可畫的紋理時回傳 NULL
+static gs_texture_t *crosshair_image_texture(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                             float *draw_scale)
+{
+    // 圖片在 create / update 時請求，背景解碼完成後才會替換成新圖片
+    gs_texture_t *texture = texture_slot_get(&d->custom_image);
+    // 靜態圖片已在背景縮小到接近顯示尺寸，只需補足剩餘的比例；動畫的格維持原尺寸
+    *draw_scale = s->image_scale / texture_slot_baked_scale(&d->custom_image);
+    if (d->anim_image && !anim_image_is_static(d->anim_image)) {
+        gs_texture_t *frame_texture = anim_image_get_texture(d->anim_image);
+        if (frame_texture) {
+            texture = frame_texture;
+            *draw_scale = s->image_scale;
         }
     }
-
-    gs_texture_t *tex = gs_texture_create(texture_size, texture_size, GS_RGBA, 1,
-                                          (const uint8_t **)&data, GS_DYNAMIC);
-    bfree(data);
-    return tex;
+    return texture;
 }
 
-// 創建實心圓形紋理的輔助函數
-static gs_texture_t *create_solid_circle_texture(int radius, uint32_t color, float alpha)
+// 以準心為中心繪製自訂圖片紋理
+static void crosshair_draw_image(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                 gs_texture_t *texture, float draw_scale, float center_x, float center_y)
 {
-    int texture_size = radius * 2;
-    uint8_t *data = (uint8_t *)bzalloc(texture_size * texture_size * 4);
+    uint32_t texture_width = gs_texture_get_width(texture);
+    uint32_t texture_height = gs_texture_get_height(texture);
+    
+    // 設定混合狀態（alpha 通道與批次繪製相同，可畫進靜態畫面快取）
+    gs_blend_state_push();
+    gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+    gs_enable_color(true, true, true, true);
+    
+    // 使用預設效果
+    gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+    gs_technique_t *tech = gs_effect_get_technique(effect, "Draw");
+    gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+    
+    gs_technique_begin(tech);
+    gs_technique_begin_pass(tech, 0);
+    
+    // 繪製自訂圖片紋理，確保紋理中心對齊到準心位置
+    gs_matrix_push();
+    gs_matrix_translate3f(center_x, center_y, 0.0f);
+    // 以準心為中心旋轉與縮放
+    if (s->image_rotation != 0.0f) {
+        gs_matrix_rotaa4f(0.0f, 0.0f, 1.0f, s->image_rotation * (float)M_PI / 180.0f);
+    }
+    if (draw_scale != 1.0f) {
+        gs_matrix_scale3f(draw_scale, draw_scale, 1.0f);
+    }
+    // 將紋理中心對齊到準心位置
+    gs_matrix_translate3f(-(float)texture_width / 2.0f, -(float)texture_height / 2.0f, 0.0f);
+    gs_draw_sprite(texture, 0, texture_width, texture_height);
+    gs_matrix_pop();
+    
+    gs_technique_end_pass(tech);
+    gs_technique_end(tech);
+    
+    // 恢復混合狀態
+    gs_blend_state_pop();
+    d->frame_draw_calls++;
+}
 
-    float center = (float)texture_size / 2.0f;
-    float circle_radius = (float)radius;
-    float edge_distance = 1.0f;
+// 以三角形帶近似的實心圓點（後備繪製沒有 SDF 效果可用）
+static void crosshair_batch_polygon_dot(struct draw_batch *batch, float cx, float cy, float radius, uint32_t color)
+{
+    struct vec3 *points;
+    uint32_t *colors;
+    if (!draw_batch_strip_reserve(batch, FALLBACK_DOT_SEGMENTS, &points, &colors)) return;
+    // 頂點沿圓周左右交錯（0, 1, n-1, 2, n-2, ...），三角形帶剛好鋪滿整個凸多邊形
+    for (int i = 0; i < FALLBACK_DOT_SEGMENTS; ++i) {
+        int k = (i & 1) ? (i + 1) / 2 : (FALLBACK_DOT_SEGMENTS - i / 2) % FALLBACK_DOT_SEGMENTS;
+        float angle = (float)k * 2.0f * (float)M_PI / (float)FALLBACK_DOT_SEGMENTS;
+        vec3_set(&points[i], cx + radius * cosf(angle), cy + radius * sinf(angle), 0.0f);
+        colors[i] = color;
+    }
+    draw_batch_strip_commit(batch, FALLBACK_DOT_SEGMENTS);
+}
 
-    uint8_t r = (color >> 16) & 0xFF;
-    uint8_t g = (color >> 8) & 0xFF;
-    uint8_t b = color & 0xFF;
-    uint8_t a = (uint8_t)(alpha * 255);
-
-    for (int y = 0; y < texture_size; y++) {
-        for (int x = 0; x < texture_size; x++) {
-            float dx = (float)x - center;
-            float dy = (float)y - center;
-            float distance = sqrtf(dx * dx + dy * dy);
-
-            size_t index = (y * texture_size + x) * 4;
-            if (distance <= circle_radius + edge_distance) {
-                float alpha_multiplier = 1.0f;
-                if (distance > circle_radius - edge_distance) {
-                    // 邊緣抗鋸齒
-                    alpha_multiplier = smoothstep(circle_radius, circle_radius - edge_distance, distance);
-                }
-
-                data[index + 0] = r;
-                data[index + 1] = g;
-                data[index + 2] = b;
-                data[index + 3] = (uint8_t)(a * alpha_multiplier);
+// 將追蹤線寫入批次；sdf 為 false 時（後備繪製）路徑點改以多邊形近似，緞帶本來就只用頂點顏色
+static void crosshair_batch_tracking_line(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                          struct draw_batch *batch, float center_x, float center_y, bool sdf)
+{
+    if (s->tracking_line_mode == TRACKING_MODE_LINEAR) {
+        // 線性模式：從畫面中心到準心的直線，兩端延伸半個粗細，確保完全覆蓋到準心中心
+        draw_batch_line(batch, center_x, center_y, center_x + d->offset_x, center_y + d->offset_y,
+                        (float)s->tracking_line_thickness,
+                        crosshair_vertex_color(s->tracking_line_color, s->tracking_line_alpha));
+    } else if (s->tracking_line_mode == TRACKING_MODE_PATH) {
+        // 路徑模式：每個路徑點一個圓點四邊形，透明度寫在頂點顏色中
+        const struct path_buffer *points = &d->path_points;
+        if (points->count == 0 || s->path_circle_radius <= 0.0f) return;
+
+        uint64_t current_time = os_gettime_ns();
+        uint64_t lifetime_ns = (uint64_t)(s->path_lifetime * 1000000000.0f);
+        float half = s->path_circle_radius;
+        uint32_t rgb = argb_to_vertex_rgb(s->path_circle_color);
+
+        for (int i = 0; i < points->count; ++i) {
+            int pi = path_buffer_index(points, i);
+            uint64_t age = current_time - points->timestamp[pi];
+            float age_ratio = lifetime_ns > 0 ? (float)age / (float)lifetime_ns : 1.0f;
+            if (age_ratio < 0.0f) age_ratio = 0.0f;
+            if (age_ratio > 1.0f) age_ratio = 1.0f;
+            // 連續淡出，不再量化成 21 階
+            uint32_t a = (uint32_t)((1.0f - age_ratio) * 255.0f + 0.5f);
+            if (a == 0) continue;
+
+            if (sdf) {
+                draw_batch_shape(batch, DRAW_SHAPE_DOT, points->x[pi], points->y[pi], half, half, half, 0.0f,
+                                 rgb | (a << 24));
             } else {
-                // 透明背景
-                data[index + 0] = 0;
-                data[index + 1] = 0;
-                data[index + 2] = 0;
-                data[index + 3] = 0;
+                crosshair_batch_polygon_dot(batch, points->x[pi], points->y[pi], half, rgb | (a << 24));
             }
         }
+    } else if (s->tracking_line_mode == TRACKING_MODE_RIBBON) {
+        // 緞帶模式：已確定的曲線段直接展開，只有連到準心的最後兩段每幀重新細分
+        const struct ribbon *ribbon = &d->ribbon;
+        if (ribbon->point_count == 0) return;
+
+        struct ribbon_style style;
+        crosshair_ribbon_style(s, &style);
+
+        size_t max_vertices = ribbon_max_vertices(ribbon);
+        struct vec3 *points;
+        uint32_t *colors;
+        if (!draw_batch_strip_reserve(batch, max_vertices, &points, &colors)) return;
+        size_t vert_count = ribbon_build(ribbon, &style, center_x + d->offset_x, center_y + d->offset_y,
+                                         os_gettime_ns(), points, colors, max_vertices);
+        if (vert_count >= 4) {
+            draw_batch_strip_commit(batch, vert_count);
+        }
     }
-
-    gs_texture_t *tex = gs_texture_create(texture_size, texture_size, GS_RGBA, 1,
-                                          (const uint8_t **)&data, GS_DYNAMIC);
-    bfree(data);
-    return tex;
 }
 
-static gs_texture_t *create_white_circle_texture(int radius)
+// 批次繪製：自訂圖片以外的圖元依原本的圖層順序寫入同一個頂點緩衝區
+// 沒有自訂圖片時整幀只有一次繪製呼叫；有圖片時以圖片為界分成上下兩段
+static void crosshair_render_batched(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                     uint32_t width, uint32_t height)
 {
-    int texture_size = radius * 2;
-    uint8_t *data = (uint8_t *)bzalloc(texture_size * texture_size * 4);
-
-    float center = (float)texture_size / 2.0f;
-    float circle_radius = (float)radius;
-    float edge_distance = 1.0f;
-
-    for (int y = 0; y < texture_size; y++) {
-        for (int x = 0; x < texture_size; x++) {
-            float dx = (float)x - center;
-            float dy = (float)y - center;
-            float distance = sqrtf(dx * dx + dy * dy);
-
-            size_t index = (y * texture_size + x) * 4;
-            if (distance <= circle_radius + edge_distance) {
-                float alpha_multiplier = 1.0f;
-                if (distance > circle_radius - edge_distance) {
-                    // 邊緣抗鋸齒
-                    alpha_multiplier = smoothstep(circle_radius, circle_radius - edge_distance, distance);
-                }
-
-                // 純白色紋理，透明度為1.0
-                data[index + 0] = 255; // R
-                data[index + 1] = 255; // G
-                data[index + 2] = 255; // B
-                data[index + 3] = (uint8_t)(255 * alpha_multiplier); // A
-            } else {
-                // 透明背景
-                data[index + 0] = 0;
-                data[index + 1] = 0;
-                data[index + 2] = 0;
-                data[index + 3] = 0;
-            }
+    struct draw_batch *batch = &d->batch;
+    float center_x = (float)width / 2.0f;
+    float center_y = (float)height / 2.0f;
+    float target_x = center_x + d->offset_x;
+    float target_y = center_y + d->offset_y;
+
+    draw_batch_begin(batch);
+
+    // 追蹤線（最下層）
+    if (s->show_tracking_line && s->tracking_line_alpha > 0.0f) {
+        profile_start(tracking_line_layer_name);
+        crosshair_batch_tracking_line(d, s, batch, center_x, center_y, true);
+        profile_end(tracking_line_layer_name);
+    }
+
+    // 圓圈（只有在不顯示自訂圖片時才顯示），外加 1 像素容納抗鋸齒邊緣
+    if (s->circle_alpha > 0.0f && s->circle_thickness > 0 && !s->show_default_crosshair) {
+        profile_start(circle_layer_name);
+        float outer = (float)(s->circle_radius + s->circle_thickness);
+        float extent = outer + 1.0f;
+        draw_batch_shape(batch, DRAW_SHAPE_RING, target_x, target_y, extent, extent, (float)s->circle_radius, outer,
+                         crosshair_vertex_color(s->circle_color, s->circle_alpha));
+        profile_end(circle_layer_name);
+    }
+
+    // 準心（只有在不顯示自訂圖片時才顯示），兩條臂以距離場聯集，交叉處不會重複混合
+    if (!s->show_default_crosshair && s->crosshair_alpha > 0.0f) {
+        profile_start(crosshair_layer_name);
+        float half_size = (float)s->crosshair_size / 2.0f;
+        float half_thickness = (float)s->crosshair_thickness / 2.0f;
+        float extent = ceilf(half_size > half_thickness ? half_size : half_thickness) + 1.0f;
+        draw_batch_shape(batch, DRAW_SHAPE_CROSS, target_x, target_y, extent, extent, half_size, half_thickness,
+                         crosshair_vertex_color(s->crosshair_color, s->crosshair_alpha));
+        profile_end(crosshair_layer_name);
+    }
+
+    // 自訂圖片（只有在顯示自訂圖片時才顯示）
+    gs_texture_t *image_texture = NULL;
+    float image_scale = 1.0f;
+    if (s->show_image) {
+        profile_start(image_layer_name);
+        image_texture = crosshair_image_texture(d, s, &image_scale);
+        if (!image_texture && texture_slot_loading(&d->custom_image)) {
+            // 第一次載入時以半透明圓環佔位，讓使用者知道圖片仍在解碼
+            float extent = IMAGE_PLACEHOLDER_RADIUS + 2.0f;
+            draw_batch_shape(batch, DRAW_SHAPE_RING, target_x, target_y, extent, extent,
+                             IMAGE_PLACEHOLDER_RADIUS - 1.0f, IMAGE_PLACEHOLDER_RADIUS + 1.0f,
+                             crosshair_vertex_color(0xFFFFFF, 0.5f));
         }
+        profile_end(image_layer_name);
+    }
+    size_t image_layer = draw_batch_mark(batch);
+
+    // 方框（確保顯示在最上層）
+    if (s->box_alpha > 0.0f) {
+        profile_start(box_layer_name);
+        float box_x = center_x - (float)s->box_size / 2.0f;
+        float box_y = center_y - (float)s->box_size / 2.0f;
+        float size = (float)s->box_size;
+        float thickness = (float)s->box_thickness;
+        uint32_t color = crosshair_vertex_color(s->box_color, s->box_alpha);
+        draw_batch_rect(batch, box_x, box_y, size, thickness, color);
+        draw_batch_rect(batch, box_x, box_y + size - thickness, size, thickness, color);
+        draw_batch_rect(batch, box_x, box_y, thickness, size, color);
+        draw_batch_rect(batch, box_x + size - thickness, box_y, thickness, size, color);
+        profile_end(box_layer_name);
     }
 
-    gs_texture_t *tex = gs_texture_create(texture_size, texture_size, GS_RGBA, 1,
-                                          (const uint8_t **)&data, GS_DYNAMIC);
-    bfree(data);
-    return tex;
+    profile_start(batch_upload_name);
+    draw_batch_upload(batch);
+    profile_end(batch_upload_name);
+
+    profile_start(batch_draw_name);
+    gs_technique_t *tech = effect_manager_technique(CROSSHAIR_EFFECT_BATCH);
+    if (image_texture) {
+        d->frame_draw_calls += draw_batch_draw(batch, tech, 0, image_layer);
+        profile_start(image_layer_name);
+        crosshair_draw_image(d, s, image_texture, image_scale, target_x, target_y);
+        profile_end(image_layer_name);
+        d->frame_draw_calls += draw_batch_draw(batch, tech, image_layer, batch->count);
+    } else {
+        d->frame_draw_calls += draw_batch_draw(batch, tech, 0, batch->count);
+    }
+    profile_end(batch_draw_name);
 }
 
-
-static uint32_t crosshair_box_get_width(void *data)
+// 畫面是否只由設定與準心位置決定（沒有存活的路徑點、播放中的動畫或載入中的圖片）
+static bool crosshair_frame_is_static(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                      gs_texture_t **image)
 {
-    struct dr_cursor_tracker_data *d = data;
-    return d ? (uint32_t)d->box_size : 300;
+    *image = NULL;
+    if (s->show_tracking_line && s->tracking_line_alpha > 0.0f) {
+        if (s->tracking_line_mode == TRACKING_MODE_PATH && d->path_points.count > 0) return false;
+        if (s->tracking_line_mode == TRACKING_MODE_RIBBON && d->ribbon.point_count > 0) return false;
+    }
+    if (s->show_image) {
+        if (d->anim_image && !anim_image_is_static(d->anim_image)) return false;
+        *image = texture_slot_get(&d->custom_image);
+        // 載入中顯示佔位圓環，完成後才會有紋理
+        if (!*image) return false;
+    }
+    return true;
 }
 
-static uint32_t crosshair_box_get_height(void *data)
+// 以靜態畫面快取繪製整幀；畫面與上一幀不同時回傳 false，由呼叫端直接繪製
+static bool crosshair_render_cached(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                    uint32_t width, uint32_t height)
 {
-    struct dr_cursor_tracker_data *d = data;
-    return d ? (uint32_t)d->box_size : 300;
+    struct static_layer_key key;
+    memset(&key, 0, sizeof(key));
+    bool is_static = crosshair_frame_is_static(d, s, &key.image);
+    key.generation = (uint64_t)os_atomic_load_long(&d->settings_generation);
+    key.width = width;
+    key.height = height;
+    key.offset_x = d->offset_x;
+    key.offset_y = d->offset_y;
+
+    // 準心移動中每幀都不同，連續兩幀相同才值得建立快取
+    bool repeated = memcmp(&key, &d->last_frame_key, sizeof(key)) == 0;
+    d->last_frame_key = key;
+    if (!is_static || !repeated || width == 0 || height == 0) return false;
+
+    if (!d->static_layer_valid || memcmp(&key, &d->static_layer_key, sizeof(key)) != 0) {
+        if (!d->static_layer) {
+            d->static_layer = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+            if (!d->static_layer) return false;
+        }
+        gs_texrender_reset(d->static_layer);
+        if (!gs_texrender_begin(d->static_layer, width, height)) return false;
+        struct vec4 clear_color;
+        vec4_zero(&clear_color);
+        gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+        gs_ortho(0.0f, (float)width, 0.0f, (float)height, -100.0f, 100.0f);
+        crosshair_render_batched(d, s, width, height);
+        gs_texrender_end(d->static_layer);
+        d->static_layer_key = key;
+        d->static_layer_valid = true;
+        crosshair_stats_add_rebuild(&d->stats);
+    } else {
+        d->static_layer_hits++;
+    }
+
+    // 快取的顏色已預乘 alpha
+    gs_texture_t *texture = gs_texrender_get_texture(d->static_layer);
+    gs_blend_state_push();
+    gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+    gs_enable_color(true, true, true, true);
+
+    gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+    gs_technique_t *tech = gs_effect_get_technique(effect, "Draw");
+    gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+    gs_technique_begin(tech);
+    gs_technique_begin_pass(tech, 0);
+    gs_draw_sprite(texture, 0, width, height);
+    gs_technique_end_pass(tech);
+    gs_technique_end(tech);
+
+    gs_blend_state_pop();
+    d->frame_draw_calls++;
+    return true;
 }
 
-static void crosshair_box_render(void *data, gs_effect_t *effect)
+// 批次繪製效果無法使用時的後備：以內建 Solid 效果逐圖元繪製
+static void crosshair_render_fallback(struct dr_cursor_tracker_data *d, const struct crosshair_settings *s,
+                                      uint32_t width, uint32_t height)
 {
-    struct dr_cursor_tracker_data *d = data;
-    if (!d) return;
-    
-    // 獲取源的大小
-    uint32_t width = obs_source_get_base_width(d->source);
-    uint32_t height = obs_source_get_base_height(d->source);
-    
     // 計算方框位置（固定在中心）
-    float box_x = (float)width / 2.0f - (float)d->box_size / 2.0f;
-    float box_y = (float)height / 2.0f - (float)d->box_size / 2.0f;
+    float box_x = (float)width / 2.0f - (float)s->box_size / 2.0f;
+    float box_y = (float)height / 2.0f - (float)s->box_size / 2.0f;
     
     // 繪製追蹤線（最下層）
-    if (d->show_tracking_line && d->tracking_line_alpha > 0.0f) {
-        if (d->tracking_line_mode == TRACKING_MODE_LINEAR) {
-            // 線性模式：繪製直線
-            float center_x = (float)width / 2.0f;
-            float center_y = (float)height / 2.0f;
-            float target_x = center_x + d->offset_x;
-            float target_y = center_y + d->offset_y;
-            
-            // 計算線的角度
-            float dx = target_x - center_x;
-            float dy = target_y - center_y;
-            float angle = atan2f(dy, dx);
-            
-            // 計算線的長度
-            float length = sqrtf(dx * dx + dy * dy);
-            
-            gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_SOLID);
-            gs_technique_t *tech = gs_effect_get_technique(effect, "Solid");
-            
-            gs_technique_begin(tech);
-            gs_technique_begin_pass(tech, 0);
-            
-            // 設置顏色和透明度
-            set_effect_color(effect, d->tracking_line_color, d->tracking_line_alpha);
-            
-                    // 啟用標準 alpha 混合，確保線條透明度正確
+    if (s->show_tracking_line && s->tracking_line_alpha > 0.0f && s->tracking_line_mode == TRACKING_MODE_LINEAR) {
+        profile_start(tracking_line_layer_name);
+        // 線性模式：繪製直線
+        float center_x = (float)width / 2.0f;
+        float center_y = (float)height / 2.0f;
+        
+        // 計算線的角度與長度
+        float dx = d->offset_x;
+        float dy = d->offset_y;
+        float angle = atan2f(dy, dx);
+        float length = sqrtf(dx * dx + dy * dy);
+        
+        gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_SOLID);
+        gs_technique_t *tech = gs_effect_get_technique(effect, "Solid");
+        
+        // 啟用標準 alpha 混合，確保線條透明度正確
         gs_blend_state_push();
         gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
         gs_enable_color(true, true, true, true);
         
+        gs_technique_begin(tech);
+        gs_technique_begin_pass(tech, 0);
+        
+        // 設置顏色和透明度
+        set_effect_color(effect, s->tracking_line_color, s->tracking_line_alpha);
+        
         // 繪製線條
         gs_matrix_push();
         gs_matrix_translate3f(center_x, center_y, 0.0f);
         gs_matrix_rotaa4f(0.0f, 0.0f, 1.0f, angle);
         // 使用線條的中心點作為原點，確保線條的中心線對準準心中心
-        gs_matrix_translate3f(-(float)d->tracking_line_thickness / 2.0f, -(float)d->tracking_line_thickness / 2.0f, 0.0f);
+        gs_matrix_translate3f(-(float)s->tracking_line_thickness / 2.0f, -(float)s->tracking_line_thickness / 2.0f, 0.0f);
         // 延長線條長度，確保完全覆蓋到準心中心
-        gs_draw_sprite(NULL, 0, (uint32_t)(length + d->tracking_line_thickness), d->tracking_line_thickness);
+        gs_draw_sprite(NULL, 0, (uint32_t)(length + s->tracking_line_thickness), s->tracking_line_thickness);
         gs_matrix_pop();
+        d->frame_draw_calls++;
         
         gs_technique_end_pass(tech);
         gs_technique_end(tech);
         
         // 恢復混合狀態
         gs_blend_state_pop();
-        } else if (d->tracking_line_mode == TRACKING_MODE_PATH) {
-            // 路徑模式：繪製路徑點
-            if (d->path_head && d->path_point_count > 0) {
-                // 確保預生成 alpha 紋理存在
-                if (d->path_alpha_radius_cache != (int)d->path_circle_radius ||
-                    d->path_alpha_color_cache != d->path_circle_color) {
-                    for (int i = 0; i < d->path_alpha_texture_count; ++i) {
-                        if (d->path_alpha_textures[i]) {
-                            gs_texture_destroy(d->path_alpha_textures[i]);
-                            d->path_alpha_textures[i] = NULL;
-                        }
-                    }
-                    obs_enter_graphics();
-                    for (int i = 0; i < d->path_alpha_texture_count; ++i) {
-                        float alpha = (float)(i * 5) / 100.0f;
-                        d->path_alpha_textures[i] = create_solid_circle_texture((int)d->path_circle_radius, d->path_circle_color, alpha);
-                    }
-                    obs_leave_graphics();
-                    d->path_alpha_radius_cache = (int)d->path_circle_radius;
-                    d->path_alpha_color_cache = d->path_circle_color;
-                }
-
-                // 使用 Default effect 直接繪製對應 alpha 的紋理
-                if (d->path_alpha_textures[0]) {
-                    gs_effect_t *def_effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
-                    gs_technique_t *tech = gs_effect_get_technique(def_effect, "Draw");
-                    gs_eparam_t *image_param = gs_effect_get_param_by_name(def_effect, "image");
- 
-                    /* path-mode: texture size will be read per selected texture inside the loop */
-
-                    uint64_t current_time = os_gettime_ns();
-                    uint64_t lifetime_ns = (uint64_t)(d->path_lifetime * 1000000000.0f);
-
-                    int drawn_points = 0;
-
-                    // 啟用標準 alpha 混合
-                    gs_blend_state_push();
-                    gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
-                    gs_enable_color(true, true, true, true);
-
-                    // 一律使用 Default effect 的 Draw 技術進行繪製（若 color 參數存在則套色，否則直接繪製白色紋理）
-                    gs_technique_begin(tech);
-                    gs_technique_begin_pass(tech, 0);
-
-                    struct path_point *current = d->path_head;
-                    int debug_logged = 0;
-                    while (current) {
-                        uint64_t age = current_time - current->timestamp;
-                        float age_ratio = lifetime_ns > 0 ? (float)age / (float)lifetime_ns : 1.0f;
-                        if (age_ratio < 0.0f) age_ratio = 0.0f;
-                        if (age_ratio > 1.0f) age_ratio = 1.0f;
-                        float alpha = 1.0f - age_ratio; // 0~1
-                        int idx = (int)roundf(alpha * 20.0f); // 0~20
-                        if (idx < 0) idx = 0; if (idx > 20) idx = 20;
-                        gs_texture_t *tex = d->path_alpha_textures[idx];
-                        if (tex) {
-                            gs_effect_set_texture(image_param, tex);
-
-                            uint32_t w = gs_texture_get_width(tex);
-                            uint32_t h = gs_texture_get_height(tex);
-
-                            gs_matrix_push();
-                            gs_matrix_translate3f(current->x - (float)w / 2.0f, current->y - (float)h / 2.0f, 0.0f);
-                            gs_draw_sprite(tex, 0, w, h);
-                            gs_matrix_pop();
-
-                            drawn_points++;
-                        }
-                        current = current->next;
-                    }
-
-                    gs_technique_end_pass(tech);
-                    gs_technique_end(tech);
-
-                    gs_blend_state_pop();
-
-                    /* 移除每幀路徑點統計的除錯日誌 */
-                }
-            }
+        profile_end(tracking_line_layer_name);
+    } else if (s->show_tracking_line && s->tracking_line_alpha > 0.0f) {
+        profile_start(tracking_line_layer_name);
+        // 路徑與緞帶模式：照樣寫入批次緩衝區（路徑點改為多邊形），以 Solid 效果的 SolidColored 依頂點顏色一次繪製
+        struct draw_batch *batch = &d->batch;
+        draw_batch_begin(batch);
+        crosshair_batch_tracking_line(d, s, batch, (float)width / 2.0f, (float)height / 2.0f, false);
+        if (draw_batch_upload(batch)) {
+            gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_SOLID);
+            struct vec4 white;
+            vec4_set(&white, 1.0f, 1.0f, 1.0f, 1.0f);
+            gs_effect_set_vec4(gs_effect_get_param_by_name(effect, "color"), &white);
+            d->frame_draw_calls +=
+                draw_batch_draw(batch, gs_effect_get_technique(effect, "SolidColored"), 0, batch->count);
         }
+        profile_end(tracking_line_layer_name);
     }
 
     // 繪製圓圈（只有在不顯示自訂圖片時才顯示）
-    if (d->circle_alpha > 0.0f && d->circle_thickness > 0 && !d->show_default_crosshair) {
-        // 檢查是否需要重新創建圓形紋理
-        bool need_recreate = false;
-        if (!d->circle_texture) {
-            need_recreate = true;
-        } else if (d->circle_texture_size != d->circle_radius ||
-                   d->circle_texture_color != d->circle_color ||
-                   d->circle_texture_thickness != d->circle_thickness ||
-                   fabsf(d->circle_texture_alpha - d->circle_alpha) > 0.001f) {
-            need_recreate = true;
-        }
+    if (s->circle_alpha > 0.0f && s->circle_thickness > 0 && !s->show_default_crosshair) {
+        profile_start(circle_layer_name);
+        // 參數變更時已在 update 中請求重新點陣化，完成前繼續使用舊紋理
+        gs_texture_t *circle_texture = texture_slot_get(&d->circle_texture);
         
-        if (need_recreate) {
-            if (d->circle_texture) {
-                gs_texture_destroy(d->circle_texture);
-            }
-            d->circle_texture = create_circle_texture(d->circle_radius, d->circle_thickness, d->circle_color, d->circle_alpha);
-            d->circle_texture_size = d->circle_radius;
-            d->circle_texture_color = d->circle_color;
-            d->circle_texture_thickness = d->circle_thickness;
-            d->circle_texture_alpha = d->circle_alpha;
-        }
-        
-        if (d->circle_texture) {
+        if (circle_texture) {
             // 啟用標準 alpha 混合，確保圓圈透明度正確
             gs_blend_state_push();
             gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
@@ -927,7 +999,7 @@ static void crosshair_box_render(void *data, gs_effect_t *effect)
             
             gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
             gs_technique_t *tech = gs_effect_get_technique(effect, "Draw");
-            gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), d->circle_texture);
+            gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), circle_texture);
             
             gs_technique_begin(tech);
             gs_technique_begin_pass(tech, 0);
@@ -937,21 +1009,22 @@ static void crosshair_box_render(void *data, gs_effect_t *effect)
             float center_y = (float)height / 2.0f + d->offset_y;
             
             // 獲取紋理尺寸
-            uint32_t texture_width = gs_texture_get_width(d->circle_texture);
-            uint32_t texture_height = gs_texture_get_height(d->circle_texture);
+            uint32_t texture_width = gs_texture_get_width(circle_texture);
+            uint32_t texture_height = gs_texture_get_height(circle_texture);
             
             // 繪製圓形紋理，確保紋理中心對齊到準心位置
             gs_matrix_push();
             gs_matrix_translate3f(center_x, center_y, 0.0f);
             // 計算正確的縮放比例，確保圓圈大小正確
             // 紋理尺寸是 (radius + thickness) * 8，所以實際圓圈直徑是 (radius + thickness) * 2
-            float actual_circle_diameter = (float)(d->circle_radius + d->circle_thickness) * 2.0f;
+            float actual_circle_diameter = (float)(s->circle_radius + s->circle_thickness) * 2.0f;
             float scale = actual_circle_diameter / (float)texture_width;
             gs_matrix_scale3f(scale, scale, 1.0f);
             // 將紋理中心對齊到準心位置
             gs_matrix_translate3f(-(float)texture_width / 2.0f, -(float)texture_height / 2.0f, 0.0f);
-            gs_draw_sprite(d->circle_texture, 0, texture_width, texture_height);
+            gs_draw_sprite(circle_texture, 0, texture_width, texture_height);
             gs_matrix_pop();
+            d->frame_draw_calls++;
             
             gs_technique_end_pass(tech);
             gs_technique_end(tech);
@@ -959,10 +1032,12 @@ static void crosshair_box_render(void *data, gs_effect_t *effect)
             // 恢復混合狀態
             gs_blend_state_pop();
         }
+        profile_end(circle_layer_name);
     }
     
     // 繪製準心（只有在不顯示自訂圖片時才顯示）
-    if (!d->show_default_crosshair && d->crosshair_alpha > 0.0f) {
+    if (!s->show_default_crosshair && s->crosshair_alpha > 0.0f) {
+        profile_start(crosshair_layer_name);
         gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_SOLID);
         gs_technique_t *tech = gs_effect_get_technique(effect, "Solid");
         
@@ -975,7 +1050,7 @@ static void crosshair_box_render(void *data, gs_effect_t *effect)
         gs_technique_begin_pass(tech, 0);
         
         // 設置顏色和透明度
-        set_effect_color(effect, d->crosshair_color, d->crosshair_alpha);
+        set_effect_color(effect, s->crosshair_color, s->crosshair_alpha);
         
         // 計算準心位置（中心）
         float center_x = (float)width / 2.0f + d->offset_x;
@@ -985,91 +1060,46 @@ static void crosshair_box_render(void *data, gs_effect_t *effect)
         gs_matrix_translate3f(center_x, center_y, 0.0f);
         
         // 繪製十字準心
-        int crosshair_size = d->crosshair_size;
+        int crosshair_size = s->crosshair_size;
         
         // 水平線
         gs_matrix_push();
-        gs_matrix_translate3f(-(float)crosshair_size / 2.0f, -(float)d->crosshair_thickness / 2.0f, 0.0f);
-        gs_draw_sprite(NULL, 0, crosshair_size, d->crosshair_thickness);
+        gs_matrix_translate3f(-(float)crosshair_size / 2.0f, -(float)s->crosshair_thickness / 2.0f, 0.0f);
+        gs_draw_sprite(NULL, 0, crosshair_size, s->crosshair_thickness);
         gs_matrix_pop();
         
         // 垂直線
         gs_matrix_push();
-        gs_matrix_translate3f(-(float)d->crosshair_thickness / 2.0f, -(float)crosshair_size / 2.0f, 0.0f);
-        gs_draw_sprite(NULL, 0, d->crosshair_thickness, crosshair_size);
+        gs_matrix_translate3f(-(float)s->crosshair_thickness / 2.0f, -(float)crosshair_size / 2.0f, 0.0f);
+        gs_draw_sprite(NULL, 0, s->crosshair_thickness, crosshair_size);
         gs_matrix_pop();
         
         gs_matrix_pop();
+        d->frame_draw_calls += 2;
         
         gs_technique_end_pass(tech);
         gs_technique_end(tech);
         
         // 恢復混合狀態
         gs_blend_state_pop();
+        profile_end(crosshair_layer_name);
     }
     
-
-    
     // 繪製自訂圖片（只有在顯示自訂圖片時才顯示）
-    if (d->show_default_crosshair && d->crosshair_path && strlen(d->crosshair_path) > 0) {
-            // 檢查是否需要重新創建自訂圖片紋理
-        bool need_recreate = false;
-        if (!d->custom_image_texture) {
-            need_recreate = true;
-        } else if (d->custom_image_texture_size != 1) { // 使用1作為標識符
-            need_recreate = true;
-        }
-        
-        if (need_recreate) {
-            if (d->custom_image_texture) {
-                gs_texture_destroy(d->custom_image_texture);
-            }
-            d->custom_image_texture = create_crosshair_texture(d->crosshair_path); // 使用相同的載入函數
-            if (d->custom_image_texture) {
-                /* 自訂圖片紋理創建成功：不輸出資訊日誌以降低噪音 */
-                d->custom_image_texture_size = 1; // 標識符
-            }
-        }
-        
-        if (d->custom_image_texture) {
-            // 計算準心位置（中心）
-            float center_x = (float)width / 2.0f + d->offset_x;
-            float center_y = (float)height / 2.0f + d->offset_y;
-            
-            uint32_t texture_width = gs_texture_get_width(d->custom_image_texture);
-            uint32_t texture_height = gs_texture_get_height(d->custom_image_texture);
-            
-            // 設定混合狀態
-            gs_blend_state_push();
-            gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
-            gs_enable_color(true, true, true, true);
-            
-            // 使用預設效果
-            gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
-            gs_technique_t *tech = gs_effect_get_technique(effect, "Draw");
-            gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), d->custom_image_texture);
-            
-            gs_technique_begin(tech);
-            gs_technique_begin_pass(tech, 0);
-            
-            // 繪製自訂圖片紋理，確保紋理中心對齊到準心位置
-            gs_matrix_push();
-            gs_matrix_translate3f(center_x, center_y, 0.0f);
-            // 將紋理中心對齊到準心位置
-            gs_matrix_translate3f(-(float)texture_width / 2.0f, -(float)texture_height / 2.0f, 0.0f);
-            gs_draw_sprite(d->custom_image_texture, 0, texture_width, texture_height);
-            gs_matrix_pop();
-            
-            gs_technique_end_pass(tech);
-            gs_technique_end(tech);
-            
-            // 恢復混合狀態
-            gs_blend_state_pop();
+    if (s->show_image) {
+        profile_start(image_layer_name);
+        float draw_scale;
+        gs_texture_t *custom_image_texture = crosshair_image_texture(d, s, &draw_scale);
+        if (custom_image_texture) {
+            crosshair_draw_image(d, s, custom_image_texture, draw_scale, (float)width / 2.0f + d->offset_x,
+                                 (float)height / 2.0f + d->offset_y);
         }
+        profile_end(image_layer_name);
     }
     
     // 最後繪製方框（確保顯示在最上層）
-    if (d->box_alpha > 0.0f) {
+    if (s->box_alpha > 0.0f) {
+        profile_start(box_layer_name);
         gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_SOLID);
         gs_technique_t *tech = gs_effect_get_technique(effect, "Solid");
         
@@ -1082,34 +1112,93 @@ static void crosshair_box_render(void *data, gs_effect_t *effect)
         gs_technique_begin_pass(tech, 0);
         
         // 設置顏色和透明度
-        set_effect_color(effect, d->box_color, d->box_alpha);
+        set_effect_color(effect, s->box_color, s->box_alpha);
         
         // 繪製方框的四條邊
         gs_matrix_push();
         gs_matrix_translate3f(box_x, box_y, 0.0f);
         
         // 上邊
-        gs_draw_sprite(NULL, 0, d->box_size, d->box_thickness);
+        gs_draw_sprite(NULL, 0, s->box_size, s->box_thickness);
         
         // 下邊
-        gs_matrix_translate3f(0.0f, (float)(d->box_size - d->box_thickness), 0.0f);
-        gs_draw_sprite(NULL, 0, d->box_size, d->box_thickness);
+        gs_matrix_translate3f(0.0f, (float)(s->box_size - s->box_thickness), 0.0f);
+        gs_draw_sprite(NULL, 0, s->box_size, s->box_thickness);
         
         // 左邊
-        gs_matrix_translate3f(0.0f, -(float)(d->box_size - d->box_thickness), 0.0f);
-        gs_draw_sprite(NULL, 0, d->box_thickness, d->box_size);
+        gs_matrix_translate3f(0.0f, -(float)(s->box_size - s->box_thickness), 0.0f);
+        gs_draw_sprite(NULL, 0, s->box_thickness, s->box_size);
         
         // 右邊
-        gs_matrix_translate3f((float)(d->box_size - d->box_thickness), 0.0f, 0.0f);
-        gs_draw_sprite(NULL, 0, d->box_thickness, d->box_size);
+        gs_matrix_translate3f((float)(s->box_size - s->box_thickness), 0.0f, 0.0f);
+        gs_draw_sprite(NULL, 0, s->box_thickness, s->box_size);
         
         gs_matrix_pop();
+        d->frame_draw_calls += 4;
         
         gs_technique_end_pass(tech);
         gs_technique_end(tech);
         
         // 恢復混合狀態
         gs_blend_state_pop();
+        profile_end(box_layer_name);
+    }
+}
+
+static void crosshair_box_render(void *data, gs_effect_t *effect)
+{
+    struct dr_cursor_tracker_data *d = data;
+    if (!d) return;
+    UNUSED_PARAMETER(effect);
+    
+    // 獲取源的大小
+    uint32_t width = obs_source_get_base_width(d->source);
+    uint32_t height = obs_source_get_base_height(d->source);
+    
+    profile_start(render_name);
+    uint64_t render_start = os_gettime_ns();
+
+    long settings_slot;
+    const struct crosshair_settings *s = crosshair_settings_acquire(&d->settings, &settings_slot);
+    d->frame_draw_calls = 0;
+    if (effect_manager_technique(CROSSHAIR_EFFECT_BATCH)) {
+        profile_start(static_layer_name);
+        bool cached = crosshair_render_cached(d, s, width, height);
+        profile_end(static_layer_name);
+        if (!cached) {
+            crosshair_render_batched(d, s, width, height);
+        }
+    } else {
+        crosshair_render_fallback(d, s, width, height);
+    }
+    crosshair_settings_release(&d->settings, settings_slot);
+    d->total_draw_calls += d->frame_draw_calls;
+    d->rendered_frames++;
+    crosshair_stats_record_render(&d->stats, os_gettime_ns() - render_start, d->frame_draw_calls);
+
+    // 統計覆蓋層畫在整幀之上（不進入靜態畫面快取），也不計入 render 時間與繪製呼叫
+    if (d->stats_overlay) {
+        profile_start(stats_overlay_name);
+        gs_matrix_push();
+        gs_matrix_translate3f(STATS_OVERLAY_MARGIN, STATS_OVERLAY_MARGIN, 0.0f);
+        obs_source_video_render(d->stats_overlay);
+        gs_matrix_pop();
+        profile_end(stats_overlay_name);
+    }
+    profile_end(render_name);
+}
+
+// 曲線的自訂控制點只在選擇自訂時顯示
+static void set_response_curve_visible(obs_properties_t *props, obs_data_t *settings, const char *preset_key,
+                                       const char *bezier_key, bool visible)
+{
+    obs_property_t *list = obs_properties_get(props, preset_key);
+    obs_property_t *bezier = obs_properties_get(props, bezier_key);
+    if (list) {
+        obs_property_set_visible(list, visible);
+    }
+    if (bezier) {
+        obs_property_set_visible(bezier, visible && obs_data_get_int(settings, preset_key) == RESPONSE_CURVE_CUSTOM);
     }
 }
 
@@ -1123,6 +1212,7 @@ static bool crosshair_properties_modified(obs_properties_t *props, obs_property_
     }
     
     bool show_custom_image = obs_data_get_bool(settings, "show_default_crosshair");
+    bool play_image_sequence = obs_data_get_bool(settings, "play_image_sequence");
     bool show_box = obs_data_get_bool(settings, "show_box");
     bool show_tracking_line = obs_data_get_bool(settings, "show_tracking_line");
     int tracking_line_mode = (int)obs_data_get_int(settings, "tracking_line_mode");
@@ -1137,6 +1227,15 @@ static bool crosshair_properties_modified(obs_properties_t *props, obs_property_
     if (crosshair_path_prop) {
         obs_property_set_visible(crosshair_path_prop, show_custom_image);
     }
+    const char *image_props[] = {"image_scale", "image_rotation", "play_image_sequence"};
+    for (size_t i = 0; i < sizeof(image_props) / sizeof(image_props[0]); ++i) {
+        obs_property_t *prop = obs_properties_get(props, image_props[i]);
+        if (prop) obs_property_set_visible(prop, show_custom_image);
+    }
+    obs_property_t *image_fps_prop = obs_properties_get(props, "image_sequence_fps");
+    if (image_fps_prop) {
+        obs_property_set_visible(image_fps_prop, show_custom_image && play_image_sequence);
+    }
     if (crosshair_thickness_prop) {
         obs_property_set_visible(crosshair_thickness_prop, !show_custom_image);
     }
@@ -1198,10 +1297,14 @@ static bool crosshair_properties_modified(obs_properties_t *props, obs_property_
     
     // 路徑模式專用設定的可見性（只有在顯示追蹤線且模式為路徑模式時才顯示）
     bool show_path_settings = show_tracking_line && (tracking_line_mode == TRACKING_MODE_PATH);
+    // 緞帶模式共用路徑點的存活時間、間隔與上限
+    bool show_ribbon_settings = show_tracking_line && (tracking_line_mode == TRACKING_MODE_RIBBON);
+    bool show_trail_settings = show_path_settings || show_ribbon_settings;
     obs_property_t *path_circle_color_prop = obs_properties_get(props, "path_circle_color");
     obs_property_t *path_circle_radius_prop = obs_properties_get(props, "path_circle_radius");
     obs_property_t *path_lifetime_prop = obs_properties_get(props, "path_lifetime");
     obs_property_t *path_generation_interval_prop = obs_properties_get(props, "path_generation_interval");
+    obs_property_t *path_max_points_prop = obs_properties_get(props, "path_max_points");
     
     if (path_circle_color_prop) {
         obs_property_set_visible(path_circle_color_prop, show_path_settings);
@@ -1210,20 +1313,46 @@ static bool crosshair_properties_modified(obs_properties_t *props, obs_property_
         obs_property_set_visible(path_circle_radius_prop, show_path_settings);
     }
     if (path_lifetime_prop) {
-        obs_property_set_visible(path_lifetime_prop, show_path_settings);
+        obs_property_set_visible(path_lifetime_prop, show_trail_settings);
     }
     if (path_generation_interval_prop) {
-        obs_property_set_visible(path_generation_interval_prop, show_path_settings);
+        obs_property_set_visible(path_generation_interval_prop, show_trail_settings);
+    }
+    if (path_max_points_prop) {
+        obs_property_set_visible(path_max_points_prop, show_trail_settings);
+    }
+    obs_property_t *ribbon_color_prop = obs_properties_get(props, "ribbon_color");
+    obs_property_t *ribbon_width_prop = obs_properties_get(props, "ribbon_width");
+    obs_property_t *ribbon_full_speed_prop = obs_properties_get(props, "ribbon_full_speed");
+    obs_property_t *ribbon_simplify_prop = obs_properties_get(props, "ribbon_simplify_tolerance");
+    if (ribbon_color_prop) {
+        obs_property_set_visible(ribbon_color_prop, show_ribbon_settings);
+    }
+    if (ribbon_width_prop) {
+        obs_property_set_visible(ribbon_width_prop, show_ribbon_settings);
+    }
+    if (ribbon_full_speed_prop) {
+        obs_property_set_visible(ribbon_full_speed_prop, show_ribbon_settings);
+    }
+    if (ribbon_simplify_prop) {
+        obs_property_set_visible(ribbon_simplify_prop, show_ribbon_settings);
     }
     
     // 根據準心模式來顯示/隱藏速度設定群組
     int crosshair_mode = (int)obs_data_get_int(settings, "crosshair_mode");
     bool show_speed_settings = (crosshair_mode == MODE_MOVEMENT); // 只有在移動模式下才顯示速度設定
+
+    // 螢幕選擇只在座標模式下顯示
+    obs_property_t *coordinate_monitor_prop = obs_properties_get(props, "coordinate_monitor");
+    if (coordinate_monitor_prop) {
+        obs_property_set_visible(coordinate_monitor_prop, crosshair_mode == MODE_COORDINATE);
+    }
     
     // 獲取速度設定群組中的所有屬性
     obs_property_t *recenter_speed_center_prop = obs_properties_get(props, "recenter_speed_center");
     obs_property_t *recenter_speed_edge_prop = obs_properties_get(props, "recenter_speed_edge");
     obs_property_t *sensitivity_prop = obs_properties_get(props, "sensitivity");
+    obs_property_t *use_raw_input_prop = obs_properties_get(props, "use_raw_input");
     obs_property_t *crosshair_move_speed_center_prop = obs_properties_get(props, "crosshair_move_speed_center");
     obs_property_t *crosshair_move_speed_edge_prop = obs_properties_get(props, "crosshair_move_speed_edge");
     obs_property_t *enable_idle_recenter_prop = obs_properties_get(props, "enable_idle_recenter");
@@ -1241,6 +1370,9 @@ static bool crosshair_properties_modified(obs_properties_t *props, obs_property_
     if (sensitivity_prop) {
         obs_property_set_visible(sensitivity_prop, show_speed_settings);
     }
+    if (use_raw_input_prop) {
+        obs_property_set_visible(use_raw_input_prop, show_speed_settings);
+    }
     if (crosshair_move_speed_center_prop) {
         obs_property_set_visible(crosshair_move_speed_center_prop, show_speed_settings);
     }
@@ -1262,10 +1394,32 @@ static bool crosshair_properties_modified(obs_properties_t *props, obs_property_
     if (idle_recenter_boost_prop) {
         obs_property_set_visible(idle_recenter_boost_prop, show_idle_settings);
     }
+
+    set_response_curve_visible(props, settings, "recenter_curve", "recenter_bezier", show_speed_settings);
+    set_response_curve_visible(props, settings, "move_speed_curve", "move_speed_bezier", show_speed_settings);
+    set_response_curve_visible(props, settings, "idle_boost_curve", "idle_boost_bezier", show_idle_settings);
     
     return true;
 }
 
+// 曲線預設值清單與自訂控制點欄位
+static void add_response_curve_properties(obs_properties_t *group, const char *preset_key, const char *bezier_key,
+                                          const char *text_key)
+{
+    obs_property_t *list = obs_properties_add_list(group, preset_key, obs_module_text(text_key),
+        OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+    obs_property_list_add_int(list, obs_module_text("CurveConstant"), RESPONSE_CURVE_CONSTANT);
+    obs_property_list_add_int(list, obs_module_text("CurveLinear"), RESPONSE_CURVE_LINEAR);
+    obs_property_list_add_int(list, obs_module_text("CurveEaseIn"), RESPONSE_CURVE_EASE_IN);
+    obs_property_list_add_int(list, obs_module_text("CurveEaseOut"), RESPONSE_CURVE_EASE_OUT);
+    obs_property_list_add_int(list, obs_module_text("CurveEaseInOut"), RESPONSE_CURVE_EASE_IN_OUT);
+    obs_property_list_add_int(list, obs_module_text("CurveCustom"), RESPONSE_CURVE_CUSTOM);
+    obs_property_set_modified_callback(list, crosshair_properties_modified);
+
+    obs_property_t *bezier = obs_properties_add_text(group, bezier_key, obs_module_text("CurveBezier"), OBS_TEXT_DEFAULT);
+    obs_property_set_long_description(bezier, obs_module_text("CurveBezier.Description"));
+}
+
 static obs_properties_t *crosshair_box_properties(void *data)
 {
     obs_properties_t *props = obs_properties_create();
@@ -1289,8 +1443,20 @@ static obs_properties_t *crosshair_box_properties(void *data)
     obs_property_list_add_int(mode_list, obs_module_text("MovementMode"), MODE_MOVEMENT);
     obs_property_list_add_int(mode_list, obs_module_text("CoordinateMode"), MODE_COORDINATE);
     obs_property_set_modified_callback(mode_list, crosshair_properties_modified);
+
+    // 座標模式的螢幕選擇（螢幕依位置由左至右、由上至下編號）
+    obs_property_t *monitor_list = obs_properties_add_list(crosshair_group, "coordinate_monitor",
+        obs_module_text("CoordinateMonitor"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+    obs_property_list_add_int(monitor_list, obs_module_text("MonitorUnderCursor"), COORDINATE_MONITOR_AUTO);
+    obs_property_list_add_int(monitor_list, obs_module_text("VirtualDesktop"), COORDINATE_MONITOR_DESKTOP);
+    for (int i = 0; i < 8; ++i) {
+        char name[64];
+        snprintf(name, sizeof(name), "%s %d", obs_module_text("Monitor"), i + 1);
+        obs_property_list_add_int(monitor_list, name, i);
+    }
     
     obs_properties_add_int(crosshair_group, "max_offset", obs_module_text("MaxOffset"), 10, 500, 1);
+    obs_properties_add_int(crosshair_group, "input_sample_rate", obs_module_text("InputSampleRate"), 30, 8000, 1);
     
     // 添加自訂圖片選項，並設定回調函數
     obs_property_t *show_custom_image_prop = obs_properties_add_bool(crosshair_group, "show_default_crosshair", obs_module_text("ShowCustomImage"));
@@ -1298,6 +1464,18 @@ static obs_properties_t *crosshair_box_properties(void *data)
     
     // 自訂圖片路徑（當 show_default_crosshair 為 true 時顯示）
     obs_properties_add_path(crosshair_group, "crosshair_path", obs_module_text("CrosshairImage"), OBS_PATH_FILE, obs_module_text("Browse"), NULL);
+    // 自訂圖片的縮放與旋轉：縮小在載入時完成並產生 mip 鏈
+    obs_properties_add_float_slider(crosshair_group, "image_scale", obs_module_text("ImageScale"), 0.05, 4.0, 0.01);
+    obs_properties_add_float_slider(crosshair_group, "image_rotation", obs_module_text("ImageRotation"), -180.0, 180.0,
+                                    1.0);
+    // 圖片序列播放（預設關閉）與幀率（GIF 使用檔案內的每格時間）
+    obs_property_t *play_sequence = obs_properties_add_bool(crosshair_group, "play_image_sequence",
+                                                            obs_module_text("PlayImageSequence"));
+    obs_property_set_long_description(play_sequence, obs_module_text("PlayImageSequence.Description"));
+    obs_property_set_modified_callback(play_sequence, crosshair_properties_modified);
+    obs_property_t *image_fps = obs_properties_add_float_slider(crosshair_group, "image_sequence_fps",
+                                                                obs_module_text("ImageSequenceFps"), 1.0, 120.0, 1.0);
+    obs_property_set_long_description(image_fps, obs_module_text("ImageSequenceFps.Description"));
     
     // 準心十字設定（當 show_default_crosshair 為 false 時顯示）
     obs_properties_add_int_slider(crosshair_group, "crosshair_thickness", obs_module_text("CrosshairCrossLength"), 1, 2000, 1);
@@ -1325,6 +1503,7 @@ static obs_properties_t *crosshair_box_properties(void *data)
         obs_module_text("TrackingLineMode"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
     obs_property_list_add_int(tracking_mode_list, obs_module_text("LinearMode"), TRACKING_MODE_LINEAR);
     obs_property_list_add_int(tracking_mode_list, obs_module_text("PathMode"), TRACKING_MODE_PATH);
+    obs_property_list_add_int(tracking_mode_list, obs_module_text("RibbonMode"), TRACKING_MODE_RIBBON);
     obs_property_set_modified_callback(tracking_mode_list, crosshair_properties_modified);
     
     obs_properties_add_color(tracking_line_group, "tracking_line_color", obs_module_text("TrackingLineColor"));
@@ -1336,6 +1515,15 @@ static obs_properties_t *crosshair_box_properties(void *data)
     obs_properties_add_int_slider(tracking_line_group, "path_circle_radius", obs_module_text("PathCircleRadius"), 1, 50, 1);
     obs_properties_add_float_slider(tracking_line_group, "path_lifetime", obs_module_text("PathLifetime"), 0.1, 10.0, 0.1);
     obs_properties_add_float_slider(tracking_line_group, "path_generation_interval", obs_module_text("PathGenerationInterval"), 5.0f, 100.0f, 5.0f);
+    obs_properties_add_int(tracking_line_group, "path_max_points", obs_module_text("PathMaxPoints"), 16, 100000, 1);
+
+    // 緞帶模式設定
+    obs_properties_add_color(tracking_line_group, "ribbon_color", obs_module_text("RibbonColor"));
+    obs_properties_add_float_slider(tracking_line_group, "ribbon_width", obs_module_text("RibbonWidth"), 1.0, 64.0, 1.0);
+    obs_properties_add_float_slider(tracking_line_group, "ribbon_full_speed", obs_module_text("RibbonFullSpeed"), 100.0, 10000.0, 100.0);
+    obs_property_t *ribbon_simplify = obs_properties_add_float_slider(tracking_line_group, "ribbon_simplify_tolerance",
+        obs_module_text("RibbonSimplifyTolerance"), 0.0, 5.0, 0.1);
+    obs_property_set_long_description(ribbon_simplify, obs_module_text("RibbonSimplifyTolerance.Description"));
     
     obs_properties_add_group(props, "tracking_line_settings", obs_module_text("TrackingLineSettings"), OBS_GROUP_NORMAL, tracking_line_group);
     
@@ -1343,16 +1531,27 @@ static obs_properties_t *crosshair_box_properties(void *data)
     obs_properties_t *speed_group = obs_properties_create();
     obs_properties_add_float_slider(speed_group, "recenter_speed_center", obs_module_text("CenterReboundSpeed"), 0.0, 20.0, 0.01);
     obs_properties_add_float_slider(speed_group, "recenter_speed_edge", obs_module_text("OuterReboundSpeed"), 0.0, 20.0, 0.01);
+    add_response_curve_properties(speed_group, "recenter_curve", "recenter_bezier", "ReboundCurve");
     obs_properties_add_float_slider(speed_group, "sensitivity", obs_module_text("CrosshairSensitivity"), 0.01, 10.0, 0.01);
+    obs_properties_add_bool(speed_group, "use_raw_input", obs_module_text("UseRawInput"));
     obs_properties_add_float_slider(speed_group, "crosshair_move_speed_center", obs_module_text("CrosshairCenterMoveSpeed"), 0.0, 20.0, 0.01);
     obs_properties_add_float_slider(speed_group, "crosshair_move_speed_edge", obs_module_text("CrosshairOuterMoveSpeed"), 0.0, 20.0, 0.01);
+    add_response_curve_properties(speed_group, "move_speed_curve", "move_speed_bezier", "MoveSpeedCurve");
     obs_property_t *enable_idle_recenter_prop = obs_properties_add_bool(speed_group, "enable_idle_recenter", obs_module_text("EnableIdleRecenter"));
     obs_property_set_modified_callback(enable_idle_recenter_prop, crosshair_properties_modified);
     obs_properties_add_float_slider(speed_group, "idle_recenter_delay", obs_module_text("IdleRecenterDelay"), 0.0, 2.0, 0.1);
     obs_properties_add_float_slider(speed_group, "idle_recenter_time", obs_module_text("IdleRecenterTime"), 0.1, 5.0, 0.1);
     obs_properties_add_float_slider(speed_group, "idle_recenter_boost", obs_module_text("IdleRecenterBoost"), 0.0, 10.0, 0.01);
+    add_response_curve_properties(speed_group, "idle_boost_curve", "idle_boost_bezier", "IdleBoostCurve");
     obs_properties_add_group(props, "speed_settings", obs_module_text("SpeedSettings"), OBS_GROUP_NORMAL, speed_group);
     
+    // 除錯設定群組
+    obs_properties_t *debug_group = obs_properties_create();
+    obs_property_t *stats_overlay = obs_properties_add_bool(debug_group, "show_stats_overlay",
+                                                            obs_module_text("ShowStatsOverlay"));
+    obs_property_set_long_description(stats_overlay, obs_module_text("ShowStatsOverlay.Description"));
+    obs_properties_add_group(props, "debug_settings", obs_module_text("DebugSettings"), OBS_GROUP_NORMAL, debug_group);
+    
     // 初始化屬性可見性
     if (data) {
         struct dr_cursor_tracker_data *d = (struct dr_cursor_tracker_data*)data;
@@ -1371,14 +1570,20 @@ static obs_properties_t *crosshair_box_properties(void *data)
 static void crosshair_box_defaults(obs_data_t *settings)
 {
     obs_data_set_default_int(settings, "crosshair_mode", MODE_MOVEMENT);
+    obs_data_set_default_int(settings, "coordinate_monitor", COORDINATE_MONITOR_AUTO);
     obs_data_set_default_int(settings, "box_size", 500);
     obs_data_set_default_int(settings, "box_color", uint32_to_obs_color(0xFF0000FF)); // 藍色
     obs_data_set_default_int(settings, "box_thickness", 4);
     obs_data_set_default_double(settings, "box_alpha", 1.0);
     
     obs_data_set_default_int(settings, "max_offset", 200);
+    obs_data_set_default_int(settings, "input_sample_rate", 1000);
     
     obs_data_set_default_bool(settings, "show_default_crosshair", false);
+    obs_data_set_default_double(settings, "image_scale", 1.0);
+    obs_data_set_default_double(settings, "image_rotation", 0.0);
+    obs_data_set_default_bool(settings, "play_image_sequence", false);
+    obs_data_set_default_double(settings, "image_sequence_fps", 24.0);
     obs_data_set_default_int(settings, "crosshair_thickness", 48);
     obs_data_set_default_int(settings, "crosshair_color", uint32_to_obs_color(0xFFFF0000)); // 紅色
     obs_data_set_default_int(settings, "crosshair_size", 4);
@@ -1405,16 +1610,31 @@ static void crosshair_box_defaults(obs_data_t *settings)
     obs_data_set_default_int(settings, "path_circle_color", uint32_to_obs_color(0xFF00FF00)); // 綠色
     obs_data_set_default_double(settings, "path_generation_interval", 20.0); // 距離間隔：20像素
     obs_data_set_default_double(settings, "path_lifetime", 2.0);
+    obs_data_set_default_int(settings, "path_max_points", 4096);
+    obs_data_set_default_int(settings, "ribbon_color", uint32_to_obs_color(0xFF00FFFF)); // 青色
+    obs_data_set_default_double(settings, "ribbon_width", 12.0);
+    obs_data_set_default_double(settings, "ribbon_full_speed", 2000.0);
+    obs_data_set_default_double(settings, "ribbon_simplify_tolerance", 0.5);
     
     obs_data_set_default_double(settings, "recenter_speed_center", 0.75);
     obs_data_set_default_double(settings, "recenter_speed_edge", 1.50);
     obs_data_set_default_double(settings, "crosshair_move_speed_center", 1.0);
     obs_data_set_default_double(settings, "crosshair_move_speed_edge", 0.05);
     obs_data_set_default_double(settings, "sensitivity", 0.25);
+    obs_data_set_default_bool(settings, "use_raw_input", false);
     obs_data_set_default_bool(settings, "enable_idle_recenter", true);
     obs_data_set_default_double(settings, "idle_recenter_delay", 0.10);
     obs_data_set_default_double(settings, "idle_recenter_time", 2.0);
     obs_data_set_default_double(settings, "idle_recenter_boost", 10.0);
+
+    // 反應曲線：移速預設只使用中心速度，與舊版行為相同
+    obs_data_set_default_int(settings, "move_speed_curve", RESPONSE_CURVE_CONSTANT);
+    obs_data_set_default_int(settings, "recenter_curve", RESPONSE_CURVE_LINEAR);
+    obs_data_set_default_int(settings, "idle_boost_curve", RESPONSE_CURVE_LINEAR);
+    obs_data_set_default_string(settings, "move_speed_bezier", "0.25, 0.1, 0.25, 1.0");
+    obs_data_set_default_string(settings, "recenter_bezier", "0.25, 0.1, 0.25, 1.0");
+    obs_data_set_default_string(settings, "idle_boost_bezier", "0.25, 0.1, 0.25, 1.0");
+    obs_data_set_default_bool(settings, "show_stats_overlay", false);
 }
 
 struct obs_source_info dr_cursor_tracker_info = {
@@ -1438,7 +1658,17 @@ OBS_MODULE_USE_DEFAULT_LOCALE("DR_CursorTracker", "en-US")
 
 bool obs_module_load(void)
 {
+    shared_sampler_init();
+    texture_worker_init();
+    effect_manager_init();
     obs_register_source(&dr_cursor_tracker_info);
     blog(LOG_INFO, BLOG_PREFIX "插件載入成功");
     return true;
-}
\ No newline at end of file
+}
+
+void obs_module_unload(void)
+{
+    effect_manager_free();
+    texture_worker_free();
+    shared_sampler_free();
+}
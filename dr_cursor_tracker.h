@@ -2,102 +2,74 @@
 #pragma once
 #include <obs-module.h>
 #include <graphics/image-file.h>
-#include <windows.h>
+#include "path_buffer.h"
+#include "ribbon.h"
+#include "shared_sampler.h"
+#include "motion.h"
+#include "texture_worker.h"
+#include "file_watcher.h"
+#include "anim_image.h"
+#include "draw_batch.h"
+#include "crosshair_settings.h"
+#include "effect_manager.h"
+#include "crosshair_stats.h"
 
-// 抗鋸齒圓圈紋理產生函式
-gs_texture_t *create_circle_texture(int radius, int thickness, uint32_t color, float alpha);
-
-// 準心運作模式
-enum crosshair_mode {
-    MODE_MOVEMENT = 0,  // 移動模式（原有的移動+回彈）
-    MODE_COORDINATE = 1 // 座標模式（根據滑鼠位置）
-};
-
-// 追蹤線模式
-enum tracking_line_mode {
-    TRACKING_MODE_LINEAR = 0,  // 線性模式（原有的直線）
-    TRACKING_MODE_PATH = 1     // 路徑模式（生成小圈路徑）
-};
-
-// 路徑點結構
-struct path_point {
-    float x;
-    float y;
-    uint64_t timestamp;
-    struct path_point *next;
+// 靜態畫面快取的鍵：與上一幀相同且沒有隨時間變化的圖層時，畫面與快取完全相同
+struct static_layer_key {
+    uint64_t generation; // 設定世代
+    uint32_t width;
+    uint32_t height;
+    float offset_x;
+    float offset_y;
+    gs_texture_t *image; // 目前顯示的自訂圖片紋理
 };
 
 struct dr_cursor_tracker_data {
-    enum crosshair_mode mode; // 準心運作模式
-    int box_size;
-    uint32_t box_color;
-    int box_thickness;
-    float box_alpha; // 方框透明度
-    bool show_default_crosshair;
-    uint32_t crosshair_color;
-    int crosshair_thickness;
-    float crosshair_alpha; // 準心透明度
-    int crosshair_size;
-    // 圓圈設定
-    uint32_t circle_color;
-    int circle_thickness;
-    float circle_alpha; // 圓圈透明度
-    int circle_radius; // 圓圈半徑
-    float recenter_speed_center; // 中心回彈速度比例 (0.0 = 0%, 20.0 = 2000%)
-    float recenter_speed_edge;   // 外圍回彈速度比例 (0.0 = 0%, 20.0 = 2000%)
-    float crosshair_move_speed_center; // 準心中心移速 (0.0 = 0%, 20.0 = 2000%)
-    float crosshair_move_speed_edge;   // 準心外圍移速 (0.0 = 0%, 20.0 = 2000%)
-    float sensitivity;
-    int max_offset;
-    char *crosshair_path;
-    // 自訂圖片紋理
-    gs_texture_t *custom_image_texture;
-    int custom_image_texture_size;
-    // 圓形紋理
-    gs_texture_t *circle_texture;
-    int circle_texture_size;
-    uint32_t circle_texture_color;
-    int circle_texture_thickness;
-    float circle_texture_alpha;
-    // 追蹤線設定
-    bool show_tracking_line;
-    enum tracking_line_mode tracking_line_mode; // 追蹤線模式
-    uint32_t tracking_line_color;
-    int tracking_line_thickness;
-    float tracking_line_alpha;
-    // 路徑模式設定
-    float path_circle_radius;
-    float path_lifetime;
-    struct path_point *path_head;
-    struct path_point *path_tail;
-    int path_point_count;
-    gs_texture_t *path_circle_texture;
-    int path_circle_texture_size;
-    uint32_t path_circle_color;
-    int path_circle_texture_thickness;
-    float path_circle_texture_alpha;
+    // 設定快照（update 時整份發佈，tick / render 不取鎖讀取；變更的資源由差異遮罩決定）
+    struct crosshair_settings_buffer settings;
+    volatile long pending_dirty; // 留給 tick 在圖形執行緒上重建的資源（enum crosshair_dirty）
+    // 自訂圖片紋理（背景解碼）
+    struct texture_slot custom_image;
+    // 自訂圖片的檔案監看（在 tick 中依目前路徑建立，變更後延遲重新載入）
+    struct file_watcher *image_watcher;
+    char *watched_image_path;
+    bool watched_image_sequence; // 目前的動畫是否允許播放圖片序列
+    uint64_t image_changed_time; // 最後一次偵測到變更的時間（0 = 無待處理的重新載入）
+    // 動態自訂圖片（GIF / 圖片序列）；未載入完成或不是動畫時顯示靜態紋理
+    struct anim_image *anim_image;
+    // 圓形紋理（SDF 效果無法使用時的後備，背景點陣化）
+    struct texture_slot circle_texture;
+    // 路徑模式
+    struct path_buffer path_points; // 路徑點環形緩衝區
     uint64_t last_path_time;
-    float path_generation_interval; // 距離間隔（像素）
-
-    // 預先生成的 alpha 紋理（0,5,10,...,100 共 21 檔）
-    gs_texture_t *path_alpha_textures[21];
-    int path_alpha_texture_count;           // 固定為 21
-    int path_alpha_radius_cache;            // 目前快取對應的半徑
-    int path_alpha_thickness_cache;         // 若改為實心可忽略
-    uint32_t path_alpha_color_cache;        // 目前快取對應的顏色
+    // 緞帶模式
+    struct ribbon ribbon;
+    // 方框、追蹤線、圓圈與準心共用的單一頂點緩衝區批次
+    struct draw_batch batch;
+    // 繪製呼叫統計（釋放時記錄平均值）
+    uint32_t frame_draw_calls;
+    uint64_t total_draw_calls;
+    uint64_t rendered_frames;
+    // 靜態畫面快取：準心靜止且沒有存活的路徑點時，整幀直接使用上一次繪製的結果
+    volatile long settings_generation;  // 設定或圖片變更時遞增，使快取失效
+    gs_texrender_t *static_layer;
+    bool static_layer_valid;
+    struct static_layer_key static_layer_key;  // 快取內容對應的鍵
+    struct static_layer_key last_frame_key;    // 上一幀的鍵（連續兩幀相同才建立快取）
+    uint64_t static_layer_hits;
+    // 執行期統計（proc handler 的 get_stats 與除錯覆蓋層）
+    struct crosshair_stats stats;
+    obs_source_t *stats_overlay; // 顯示統計的私有文字來源（在 tick 中依設定建立 / 釋放）
+    bool stats_overlay_failed;   // 文字來源無法建立，關閉設定前不再重試
 
     float offset_x;
     float offset_y;
     float last_mouse_x;
     float last_mouse_y;
     uint64_t last_update_time;
+    // 背景滑鼠取樣（全模組共用）
+    struct shared_sampler_client *sampler_client;
+    bool has_last_sample;
+    struct motion_state motion;    // 移動模式的固定步長積分器
     obs_source_t *source; // 保存源指針
-    // 靜止回彈加速設定
-    bool enable_idle_recenter;       // 是否啟用靜止回彈加速
-    float idle_recenter_delay;       // 開始加速前的延遲時間（秒）
-    float idle_recenter_time;        // 回彈加速時間（秒）
-    float idle_recenter_boost;       // 靜止回彈速度增加值 (0.5 = +50%, 1.0 = +100%)
-    float current_idle_time;         // 當前靜止時間
-    float current_recenter_speed;    // 當前回彈速度
-    bool is_mouse_moving;           // 滑鼠是否正在移動
 };
@@ -0,0 +1,209 @@
+#include "draw_batch.h"
+#include <graphics/graphics.h>
+#include <util/bmem.h>
+#include <math.h>
+#include <string.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+#define DRAW_BATCH_MIN_CAPACITY 256
+
+void draw_batch_init(struct draw_batch *batch)
+{
+    memset(batch, 0, sizeof(*batch));
+}
+
+void draw_batch_free(struct draw_batch *batch)
+{
+    if (batch->vbuffer) gs_vertexbuffer_destroy(batch->vbuffer);
+    bfree(batch->strip_points);
+    bfree(batch->strip_colors);
+    memset(batch, 0, sizeof(*batch));
+}
+
+void draw_batch_begin(struct draw_batch *batch)
+{
+    batch->count = 0;
+    batch->failed = false;
+}
+
+static gs_vertbuffer_t *draw_batch_create_buffer(size_t capacity)
+{
+    struct gs_vb_data *vb = gs_vbdata_create();
+    vb->num = capacity;
+    vb->points = bzalloc(sizeof(struct vec3) * capacity);
+    vb->colors = bzalloc(sizeof(uint32_t) * capacity);
+    vb->num_tex = 2;
+    vb->tvarray = bzalloc(sizeof(struct gs_tvertarray) * 2);
+    vb->tvarray[0].width = 2; // 相對形狀中心的像素座標
+    vb->tvarray[0].array = bzalloc(sizeof(struct vec2) * capacity);
+    vb->tvarray[1].width = 4; // 形狀參數
+    vb->tvarray[1].array = bzalloc(sizeof(struct vec4) * capacity);
+    return gs_vertexbuffer_create(vb, GS_DYNAMIC);
+}
+
+// 確保還能寫入 count 個頂點；容量不足時換成較大的緩衝區並保留本幀已寫入的頂點
+static struct gs_vb_data *draw_batch_reserve(struct draw_batch *batch, size_t count)
+{
+    if (batch->failed) return NULL;
+    size_t needed = batch->count + count;
+    if (batch->vbuffer && needed <= batch->capacity) return gs_vertexbuffer_get_data(batch->vbuffer);
+
+    size_t capacity = batch->capacity * 2;
+    if (capacity < needed) capacity = needed;
+    if (capacity < DRAW_BATCH_MIN_CAPACITY) capacity = DRAW_BATCH_MIN_CAPACITY;
+
+    gs_vertbuffer_t *vbuffer = draw_batch_create_buffer(capacity);
+    if (!vbuffer) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法建立 %zu 個頂點的批次緩衝區", capacity);
+        batch->failed = true;
+        return NULL;
+    }
+    struct gs_vb_data *vb = gs_vertexbuffer_get_data(vbuffer);
+    if (batch->vbuffer) {
+        struct gs_vb_data *old = gs_vertexbuffer_get_data(batch->vbuffer);
+        memcpy(vb->points, old->points, sizeof(struct vec3) * batch->count);
+        memcpy(vb->colors, old->colors, sizeof(uint32_t) * batch->count);
+        memcpy(vb->tvarray[0].array, old->tvarray[0].array, sizeof(struct vec2) * batch->count);
+        memcpy(vb->tvarray[1].array, old->tvarray[1].array, sizeof(struct vec4) * batch->count);
+        gs_vertexbuffer_destroy(batch->vbuffer);
+    }
+    batch->vbuffer = vbuffer;
+    batch->capacity = capacity;
+    return vb;
+}
+
+static inline void draw_batch_vertex(struct gs_vb_data *vb, size_t i, float x, float y, float lx, float ly,
+                                     const struct vec4 *shape, uint32_t color)
+{
+    vec3_set(&vb->points[i], x, y, 0.0f);
+    vb->colors[i] = color;
+    vec2_set(&((struct vec2 *)vb->tvarray[0].array)[i], lx, ly);
+    ((struct vec4 *)vb->tvarray[1].array)[i] = *shape;
+}
+
+// 以四個角寫入兩個三角形（順序：左上、右上、左下、右下，與路徑點原本的繞向相同）
+static void draw_batch_quad(struct draw_batch *batch, const float pos[4][2], const float local[4][2],
+                            const struct vec4 *shape, uint32_t color)
+{
+    struct gs_vb_data *vb = draw_batch_reserve(batch, 6);
+    if (!vb) return;
+    static const int order[6] = {0, 1, 2, 1, 3, 2};
+    for (int k = 0; k < 6; ++k) {
+        int c = order[k];
+        draw_batch_vertex(vb, batch->count + k, pos[c][0], pos[c][1], local[c][0], local[c][1], shape, color);
+    }
+    batch->count += 6;
+}
+
+void draw_batch_rect(struct draw_batch *batch, float x, float y, float width, float height, uint32_t color)
+{
+    const float pos[4][2] = {{x, y}, {x + width, y}, {x, y + height}, {x + width, y + height}};
+    const float local[4][2] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+    struct vec4 shape;
+    vec4_set(&shape, 0.0f, 0.0f, (float)DRAW_SHAPE_SOLID, 0.0f);
+    draw_batch_quad(batch, pos, local, &shape, color);
+}
+
+void draw_batch_line(struct draw_batch *batch, float x0, float y0, float x1, float y1, float thickness,
+                     uint32_t color)
+{
+    float dx = x1 - x0, dy = y1 - y0;
+    float length = sqrtf(dx * dx + dy * dy);
+    float angle = atan2f(dy, dx);
+    float c = cosf(angle), s = sinf(angle);
+    float half = thickness / 2.0f;
+
+    // 與原本的旋轉精靈相同：沿線方向 [-half, length + half]，垂直方向 [-half, half]
+    const float u[4] = {-half, length + half, -half, length + half};
+    const float v[4] = {-half, -half, half, half};
+    float pos[4][2];
+    for (int i = 0; i < 4; ++i) {
+        pos[i][0] = x0 + u[i] * c - v[i] * s;
+        pos[i][1] = y0 + u[i] * s + v[i] * c;
+    }
+    const float local[4][2] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+    struct vec4 shape;
+    vec4_set(&shape, 0.0f, 0.0f, (float)DRAW_SHAPE_SOLID, 0.0f);
+    draw_batch_quad(batch, pos, local, &shape, color);
+}
+
+void draw_batch_shape(struct draw_batch *batch, enum draw_shape kind, float cx, float cy, float extent_x,
+                      float extent_y, float shape_x, float shape_y, uint32_t color)
+{
+    const float pos[4][2] = {{cx - extent_x, cy - extent_y},
+                             {cx + extent_x, cy - extent_y},
+                             {cx - extent_x, cy + extent_y},
+                             {cx + extent_x, cy + extent_y}};
+    const float local[4][2] = {{-extent_x, -extent_y}, {extent_x, -extent_y}, {-extent_x, extent_y}, {extent_x, extent_y}};
+    struct vec4 shape;
+    vec4_set(&shape, shape_x, shape_y, (float)kind, 0.0f);
+    draw_batch_quad(batch, pos, local, &shape, color);
+}
+
+bool draw_batch_strip_reserve(struct draw_batch *batch, size_t count, struct vec3 **points, uint32_t **colors)
+{
+    if (count > batch->strip_capacity) {
+        batch->strip_points = brealloc(batch->strip_points, sizeof(struct vec3) * count);
+        batch->strip_colors = brealloc(batch->strip_colors, sizeof(uint32_t) * count);
+        batch->strip_capacity = count;
+    }
+    *points = batch->strip_points;
+    *colors = batch->strip_colors;
+    return true;
+}
+
+void draw_batch_strip_commit(struct draw_batch *batch, size_t count)
+{
+    if (count < 3) return;
+    size_t triangles = count - 2;
+    struct gs_vb_data *vb = draw_batch_reserve(batch, triangles * 3);
+    if (!vb) return;
+
+    struct vec4 shape;
+    vec4_set(&shape, 0.0f, 0.0f, (float)DRAW_SHAPE_SOLID, 0.0f);
+    size_t out = batch->count;
+    for (size_t i = 0; i < triangles; ++i) {
+        // 奇數三角形交換前兩個頂點，維持與三角形帶相同的繞向
+        size_t a = (i & 1) ? i + 1 : i;
+        size_t b = (i & 1) ? i : i + 1;
+        const size_t idx[3] = {a, b, i + 2};
+        for (int k = 0; k < 3; ++k) {
+            const struct vec3 *p = &batch->strip_points[idx[k]];
+            draw_batch_vertex(vb, out++, p->x, p->y, 0.0f, 0.0f, &shape, batch->strip_colors[idx[k]]);
+        }
+    }
+    batch->count = out;
+}
+
+bool draw_batch_upload(struct draw_batch *batch)
+{
+    if (!batch->vbuffer || batch->count == 0) return false;
+    // 容量只增不減，一般幀寫入的頂點遠少於容量：只上傳本幀寫入的部分
+    struct gs_vb_data data = *gs_vertexbuffer_get_data(batch->vbuffer);
+    data.num = batch->count;
+    gs_vertexbuffer_flush_direct(batch->vbuffer, &data);
+    return true;
+}
+
+int draw_batch_draw(struct draw_batch *batch, gs_technique_t *tech, size_t start, size_t end)
+{
+    if (!batch->vbuffer || end <= start) return 0;
+
+    // alpha 通道以 ONE 累加，畫進透明的靜態畫面快取時得到正確的覆蓋率（顏色為預乘）
+    gs_blend_state_push();
+    gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+    gs_enable_color(true, true, true, true);
+
+    gs_load_vertexbuffer(batch->vbuffer);
+    gs_load_indexbuffer(NULL);
+    gs_technique_begin(tech);
+    gs_technique_begin_pass(tech, 0);
+    gs_draw(GS_TRIS, (uint32_t)start, (uint32_t)(end - start));
+    gs_technique_end_pass(tech);
+    gs_technique_end(tech);
+    gs_load_vertexbuffer(NULL);
+
+    gs_blend_state_pop();
+    return 1;
+}
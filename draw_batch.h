@@ -0,0 +1,64 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <obs-module.h>
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+
+// 單一頂點緩衝區的圖元批次
+// 一幀內的所有純色與 SDF 圖元（方框、追蹤線、路徑點、緞帶、圓圈、十字準心）依繪製順序寫入同一個
+// 動態頂點緩衝區，以同一個混合狀態與 technique 一次繪製。每個頂點帶有顏色、相對形狀中心的像素座標
+// 與形狀參數，像素著色器依 shape.z 的種類計算覆蓋率，因此不需要逐圖元設定 uniform。
+// 需要插入其他繪製（例如自訂圖片紋理）時，以 draw_batch_mark 記下分界，分段繪製同一個緩衝區。
+
+// 形狀種類（寫在頂點的 shape.z）
+enum draw_shape {
+    DRAW_SHAPE_SOLID = 0, // 純色
+    DRAW_SHAPE_RING = 1,  // shape.xy = 內半徑, 外半徑
+    DRAW_SHAPE_CROSS = 2, // shape.xy = 臂長一半, 粗細一半
+    DRAW_SHAPE_DOT = 3,   // shape.x = 半徑
+};
+
+struct draw_batch {
+    gs_vertbuffer_t *vbuffer;
+    size_t capacity; // 頂點緩衝區可容納的頂點數
+    size_t count;    // 本幀已寫入的頂點數
+    bool failed;     // 本幀無法配置緩衝區，之後的圖元都會被略過
+
+    // 三角形帶暫存（緞帶由 ribbon_build 寫入後展開成三角形）
+    struct vec3 *strip_points;
+    uint32_t *strip_colors;
+    size_t strip_capacity;
+};
+
+void draw_batch_init(struct draw_batch *batch);
+// 需在圖形上下文中呼叫
+void draw_batch_free(struct draw_batch *batch);
+
+// 以下函式都需在圖形執行緒上呼叫
+void draw_batch_begin(struct draw_batch *batch);
+
+static inline size_t draw_batch_mark(const struct draw_batch *batch)
+{
+    return batch->count;
+}
+
+// color 為頂點顏色（0xAABBGGRR）
+void draw_batch_rect(struct draw_batch *batch, float x, float y, float width, float height, uint32_t color);
+// 從 (x0, y0) 到 (x1, y1) 的線段，兩端各延伸 thickness / 2
+void draw_batch_line(struct draw_batch *batch, float x0, float y0, float x1, float y1, float thickness,
+                     uint32_t color);
+// 置中於 (cx, cy)、半寬 / 半高為 extent_x / extent_y 的 SDF 四邊形
+void draw_batch_shape(struct draw_batch *batch, enum draw_shape kind, float cx, float cy, float extent_x,
+                      float extent_y, float shape_x, float shape_y, uint32_t color);
+
+// 取得可寫入 count 個三角形帶頂點的暫存區，寫入後以 draw_batch_strip_commit 展開成三角形
+bool draw_batch_strip_reserve(struct draw_batch *batch, size_t count, struct vec3 **points, uint32_t **colors);
+void draw_batch_strip_commit(struct draw_batch *batch, size_t count);
+
+// 上傳本幀的頂點，回傳是否有東西可畫
+bool draw_batch_upload(struct draw_batch *batch);
+// 以 tech 繪製 [start, end) 的頂點，回傳繪製呼叫次數（0 或 1）
+int draw_batch_draw(struct draw_batch *batch, gs_technique_t *tech, size_t start, size_t end);
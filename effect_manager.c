@@ -0,0 +1,115 @@
+#include "effect_manager.h"
+#include <util/threading.h>
+#include <graphics/graphics.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+// 批次繪製 Effect：方框、追蹤線、路徑點、緞帶、圓圈與準心共用同一個 technique
+// 每個頂點帶有顏色（含透明度）、相對形狀中心的像素座標 local 與形狀參數 shape，像素著色器依 shape.z 的種類
+// 計算覆蓋率：0 純色、1 圓環（內半徑, 外半徑）、2 十字（臂長一半, 粗細一半）、3 圓點（半徑）
+// 覆蓋率取像素中心到邊界的有號距離，邊緣在任何大小下都是 1 像素寬的抗鋸齒
+static const char g_batch_effect_src[] =
+    "uniform float4x4 ViewProj;\n"
+    "struct VertIn { float4 pos : POSITION; float4 color : COLOR; float2 local : TEXCOORD0; float4 shape : TEXCOORD1; };\n"
+    "VertIn VS(VertIn v) { VertIn o; o.pos = mul(float4(v.pos.xyz, 1.0), ViewProj); o.color = v.color; o.local = v.local; o.shape = v.shape; return o; }\n"
+    "float box_sdf(float2 p, float2 b) { float2 q = abs(p) - b; return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0); }\n"
+    "float4 PS(VertIn v) : TARGET {\n"
+    "    float d = -1.0;\n"
+    "    float r = length(v.local);\n"
+    "    if (v.shape.z > 2.5) d = r - v.shape.x + 0.5;\n"
+    "    else if (v.shape.z > 1.5) d = min(box_sdf(v.local, v.shape.xy), box_sdf(v.local, v.shape.yx));\n"
+    "    else if (v.shape.z > 0.5) d = max(v.shape.x - r, r - v.shape.y);\n"
+    "    return float4(v.color.rgb, v.color.a * saturate(0.5 - d));\n"
+    "}\n"
+    "technique Draw { pass { vertex_shader = VS(v); pixel_shader = PS(v); } }\n";
+
+struct managed_effect {
+    const char *name;
+    const char *src;
+    const char *technique;
+    gs_effect_t *effect;
+    gs_technique_t *tech;
+};
+
+static struct managed_effect g_effects[CROSSHAIR_EFFECT_COUNT] = {
+    [CROSSHAIR_EFFECT_BATCH] = {"DRBatchEffect", g_batch_effect_src, "Draw", NULL, NULL},
+};
+
+static pthread_mutex_t g_mutex;
+static bool g_mutex_initialized = false;
+static bool g_compiled = false; // 已嘗試編譯（失敗的效果不重試，避免每個來源都重新編譯一次）
+
+// 需持有 g_mutex
+static void effect_manager_compile(void)
+{
+    if (g_compiled) return;
+
+    obs_enter_graphics();
+    if (!gs_get_context()) {
+        // 圖形子系統尚未啟動，留給第一個來源
+        obs_leave_graphics();
+        return;
+    }
+
+    for (int i = 0; i < CROSSHAIR_EFFECT_COUNT; ++i) {
+        struct managed_effect *e = &g_effects[i];
+        char *errors = NULL;
+        e->effect = gs_effect_create(e->src, e->name, &errors);
+        if (e->effect) {
+            e->tech = gs_effect_get_technique(e->effect, e->technique);
+        } else {
+            blog(LOG_WARNING, BLOG_PREFIX "效果 %s 編譯失敗：%s", e->name, errors ? errors : "(無錯誤訊息)");
+        }
+        bfree(errors);
+    }
+    g_compiled = true;
+    obs_leave_graphics();
+}
+
+void effect_manager_init(void)
+{
+    if (g_mutex_initialized) return;
+    if (pthread_mutex_init(&g_mutex, NULL) != 0) return;
+    g_mutex_initialized = true;
+
+    pthread_mutex_lock(&g_mutex);
+    effect_manager_compile();
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void effect_manager_free(void)
+{
+    if (!g_mutex_initialized) return;
+
+    // OBS 關閉時圖形子系統可能已先釋放（連同其中的效果），此時只清除指標
+    obs_enter_graphics();
+    bool has_context = gs_get_context() != NULL;
+    for (int i = 0; i < CROSSHAIR_EFFECT_COUNT; ++i) {
+        if (has_context && g_effects[i].effect) gs_effect_destroy(g_effects[i].effect);
+        g_effects[i].effect = NULL;
+        g_effects[i].tech = NULL;
+    }
+    obs_leave_graphics();
+
+    g_compiled = false;
+    pthread_mutex_destroy(&g_mutex);
+    g_mutex_initialized = false;
+}
+
+void effect_manager_ensure(void)
+{
+    if (!g_mutex_initialized) return;
+    pthread_mutex_lock(&g_mutex);
+    effect_manager_compile();
+    pthread_mutex_unlock(&g_mutex);
+}
+
+gs_effect_t *effect_manager_get(enum crosshair_effect id)
+{
+    return g_effects[id].effect;
+}
+
+gs_technique_t *effect_manager_technique(enum crosshair_effect id)
+{
+    return g_effects[id].tech;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdbool.h>
+#include <obs-module.h>
+
+// 插件共用的 GPU 效果
+// 所有效果在 obs_module_load 時編譯一次並快取 technique，各來源只取用、不再自行建立或釋放；
+// 效果存活到模組卸載時才一起釋放。載入時圖形子系統尚未啟動的話，第一個來源建立時再編譯。
+
+enum crosshair_effect {
+    CROSSHAIR_EFFECT_BATCH, // 方框、追蹤線、圓圈與準心的批次繪製
+    CROSSHAIR_EFFECT_COUNT,
+};
+
+// obs_module_load / obs_module_unload
+void effect_manager_init(void);
+void effect_manager_free(void);
+
+// 來源建立時呼叫：尚未編譯時補編譯（已嘗試過則直接返回）
+void effect_manager_ensure(void);
+
+// 編譯失敗時回傳 NULL，呼叫端需改用後備繪製
+gs_effect_t *effect_manager_get(enum crosshair_effect id);
+gs_technique_t *effect_manager_technique(enum crosshair_effect id);
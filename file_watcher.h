@@ -0,0 +1,14 @@
+#pragma once
+#include <stdbool.h>
+
+// 單一檔案的變更監看（Linux inotify / Windows ReadDirectoryChangesW）
+// 監看的是檔案所在的目錄：許多編輯器以「寫入暫存檔再改名」的方式存檔，直接監看檔案會在第一次存檔後失效。
+// 不另開執行緒，由呼叫端（tick）以非阻塞方式輪詢。
+struct file_watcher;
+
+// 無法監看時回傳 NULL（例如目錄不存在），呼叫端照常運作，只是不會自動重新載入
+struct file_watcher *file_watcher_create(const char *path);
+void file_watcher_destroy(struct file_watcher *watcher);
+
+// 回傳自上次輪詢後檔案是否被建立、寫入、改名或刪除
+bool file_watcher_poll(struct file_watcher *watcher);
@@ -0,0 +1,68 @@
+#include "file_watcher.h"
+#include <obs-module.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+struct file_watcher {
+    int fd;
+    char *name; // 目錄內的檔名
+};
+
+struct file_watcher *file_watcher_create(const char *path)
+{
+    if (!path || !*path) return NULL;
+
+    const char *slash = strrchr(path, '/');
+    char *dir = slash ? bstrdup_n(path, (size_t)(slash - path)) : bstrdup(".");
+    if (slash && slash == path) {
+        bfree(dir);
+        dir = bstrdup("/");
+    }
+
+    struct file_watcher *w = bzalloc(sizeof(struct file_watcher));
+    w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (w->fd < 0 || inotify_add_watch(w->fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE |
+                                                         IN_DELETE | IN_ATTRIB) < 0) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法監看圖片目錄: %s", dir);
+        if (w->fd >= 0) close(w->fd);
+        bfree(dir);
+        bfree(w);
+        return NULL;
+    }
+    bfree(dir);
+    w->name = bstrdup(slash ? slash + 1 : path);
+    return w;
+}
+
+void file_watcher_destroy(struct file_watcher *watcher)
+{
+    if (!watcher) return;
+    close(watcher->fd);
+    bfree(watcher->name);
+    bfree(watcher);
+}
+
+bool file_watcher_poll(struct file_watcher *watcher)
+{
+    if (!watcher) return false;
+
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+    for (;;) {
+        ssize_t size = read(watcher->fd, buffer, sizeof(buffer));
+        if (size <= 0) break; // EAGAIN：沒有更多事件
+        for (char *p = buffer; p < buffer + size;) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            // 佇列溢位時無法得知是哪個檔案，保守地視為已變更
+            if ((ev->mask & IN_Q_OVERFLOW) || (ev->len && strcmp(ev->name, watcher->name) == 0)) {
+                changed = true;
+            }
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,107 @@
+#include "file_watcher.h"
+#include <obs-module.h>
+#include <util/platform.h>
+#include <windows.h>
+#include <wchar.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+struct file_watcher {
+    HANDLE dir;
+    OVERLAPPED overlapped;
+    DWORD buffer[2048]; // FILE_NOTIFY_INFORMATION 需要 DWORD 對齊
+    bool reading;
+    wchar_t *name; // 目錄內的檔名
+};
+
+static void file_watcher_read(struct file_watcher *w)
+{
+    ResetEvent(w->overlapped.hEvent);
+    w->reading = ReadDirectoryChangesW(w->dir, w->buffer, sizeof(w->buffer), FALSE,
+                                       FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                           FILE_NOTIFY_CHANGE_SIZE,
+                                       NULL, &w->overlapped, NULL) != 0;
+}
+
+struct file_watcher *file_watcher_create(const char *path)
+{
+    if (!path || !*path) return NULL;
+
+    wchar_t *wpath = NULL;
+    if (!os_utf8_to_wcs_ptr(path, 0, &wpath) || !wpath) return NULL;
+
+    // OBS 的檔案對話框回傳正斜線，兩種分隔字元都要處理
+    wchar_t *sep = NULL;
+    for (wchar_t *p = wpath; *p; ++p) {
+        if (*p == L'/' || *p == L'\\') sep = p;
+    }
+    if (!sep) {
+        bfree(wpath);
+        return NULL;
+    }
+
+    struct file_watcher *w = bzalloc(sizeof(struct file_watcher));
+    w->name = bwstrdup(sep + 1);
+    sep[1] = L'\0'; // 保留結尾分隔字元，讓 "C:\" 這類根目錄也能開啟
+    w->dir = CreateFileW(wpath, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                         OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    bfree(wpath);
+    w->overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+    if (w->dir == INVALID_HANDLE_VALUE || !w->overlapped.hEvent) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法監看圖片目錄: %s", path);
+        if (w->dir != INVALID_HANDLE_VALUE) CloseHandle(w->dir);
+        if (w->overlapped.hEvent) CloseHandle(w->overlapped.hEvent);
+        bfree(w->name);
+        bfree(w);
+        return NULL;
+    }
+
+    file_watcher_read(w);
+    return w;
+}
+
+void file_watcher_destroy(struct file_watcher *watcher)
+{
+    if (!watcher) return;
+    if (watcher->reading) {
+        // 等待取消完成，緩衝區釋放後系統不會再寫入
+        DWORD bytes;
+        CancelIo(watcher->dir);
+        GetOverlappedResult(watcher->dir, &watcher->overlapped, &bytes, TRUE);
+    }
+    CloseHandle(watcher->dir);
+    CloseHandle(watcher->overlapped.hEvent);
+    bfree(watcher->name);
+    bfree(watcher);
+}
+
+bool file_watcher_poll(struct file_watcher *watcher)
+{
+    if (!watcher) return false;
+    if (!watcher->reading) {
+        file_watcher_read(watcher);
+        return false;
+    }
+
+    DWORD bytes = 0;
+    if (!GetOverlappedResult(watcher->dir, &watcher->overlapped, &bytes, FALSE)) {
+        if (GetLastError() == ERROR_IO_INCOMPLETE) return false;
+        file_watcher_read(watcher);
+        return false;
+    }
+
+    // 0 位元組表示緩衝區溢位，無法得知是哪個檔案，保守地視為已變更
+    bool changed = bytes == 0;
+    size_t name_len = wcslen(watcher->name);
+    const BYTE *p = (const BYTE *)watcher->buffer;
+    while (!changed && bytes) {
+        const FILE_NOTIFY_INFORMATION *info = (const FILE_NOTIFY_INFORMATION *)p;
+        size_t len = info->FileNameLength / sizeof(WCHAR);
+        if (len == name_len && _wcsnicmp(info->FileName, watcher->name, len) == 0) changed = true;
+        if (!info->NextEntryOffset) break;
+        p += info->NextEntryOffset;
+    }
+
+    file_watcher_read(watcher);
+    return changed;
+}
@@ -0,0 +1,134 @@
+#include "image_scale.h"
+#include <util/bmem.h>
+#include <math.h>
+#include <string.h>
+
+// 一維面積平均：輸出像素 i 覆蓋來源 [i * ratio, (i + 1) * ratio)
+struct scale_taps {
+    uint32_t *first;  // 每個輸出像素的第一個來源索引
+    uint32_t *count;  // 來源像素數
+    uint32_t *offset; // 在 weights 中的起點
+    float *weights;   // 覆蓋比例（總和為 1）
+};
+
+static void scale_taps_init(struct scale_taps *taps, uint32_t src, uint32_t dst)
+{
+    double ratio = (double)src / (double)dst;
+    uint32_t max_taps = (uint32_t)ceil(ratio) + 1;
+    taps->first = bmalloc(sizeof(uint32_t) * dst);
+    taps->count = bmalloc(sizeof(uint32_t) * dst);
+    taps->offset = bmalloc(sizeof(uint32_t) * dst);
+    taps->weights = bmalloc(sizeof(float) * dst * max_taps);
+
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < dst; ++i) {
+        double start = (double)i * ratio;
+        double end = start + ratio;
+        uint32_t first = (uint32_t)floor(start);
+        uint32_t last = (uint32_t)ceil(end);
+        if (last > src) last = src;
+        taps->first[i] = first;
+        taps->offset[i] = used;
+        taps->count[i] = 0;
+        for (uint32_t s = first; s < last; ++s) {
+            double lo = start > (double)s ? start : (double)s;
+            double hi = end < (double)(s + 1) ? end : (double)(s + 1);
+            if (hi <= lo) continue;
+            if (taps->count[i] == 0) taps->first[i] = s;
+            taps->weights[used++] = (float)((hi - lo) / ratio);
+            taps->count[i]++;
+        }
+    }
+}
+
+static void scale_taps_free(struct scale_taps *taps)
+{
+    bfree(taps->first);
+    bfree(taps->count);
+    bfree(taps->offset);
+    bfree(taps->weights);
+}
+
+uint8_t *image_scale_area(const uint8_t *src, uint32_t src_width, uint32_t src_height, uint32_t dst_width,
+                          uint32_t dst_height)
+{
+    if (!src || !src_width || !src_height || !dst_width || !dst_height) return NULL;
+    if (dst_width > src_width || dst_height > src_height) return NULL;
+
+    struct scale_taps tx, ty;
+    scale_taps_init(&tx, src_width, dst_width);
+    scale_taps_init(&ty, src_height, dst_height);
+
+    // 水平方向：每一列來源縮成 dst_width 個預乘 alpha 的浮點像素
+    float *rows = bmalloc(sizeof(float) * 4 * dst_width * src_height);
+    for (uint32_t y = 0; y < src_height; ++y) {
+        const uint8_t *in = src + (size_t)y * src_width * 4;
+        float *out = rows + (size_t)y * dst_width * 4;
+        for (uint32_t x = 0; x < dst_width; ++x) {
+            float c0 = 0.0f, c1 = 0.0f, c2 = 0.0f, a = 0.0f;
+            const float *w = tx.weights + tx.offset[x];
+            const uint8_t *p = in + (size_t)tx.first[x] * 4;
+            for (uint32_t i = 0; i < tx.count[x]; ++i, p += 4) {
+                float wa = w[i] * (float)p[3];
+                c0 += wa * (float)p[0];
+                c1 += wa * (float)p[1];
+                c2 += wa * (float)p[2];
+                a += wa;
+            }
+            out[x * 4 + 0] = c0;
+            out[x * 4 + 1] = c1;
+            out[x * 4 + 2] = c2;
+            out[x * 4 + 3] = a;
+        }
+    }
+
+    // 垂直方向並還原成直接 alpha
+    uint8_t *dst = bmalloc((size_t)dst_width * dst_height * 4);
+    float *acc = bmalloc(sizeof(float) * 4 * dst_width);
+    for (uint32_t y = 0; y < dst_height; ++y) {
+        memset(acc, 0, sizeof(float) * 4 * dst_width);
+        const float *w = ty.weights + ty.offset[y];
+        for (uint32_t i = 0; i < ty.count[y]; ++i) {
+            const float *row = rows + (size_t)(ty.first[y] + i) * dst_width * 4;
+            for (uint32_t x = 0; x < dst_width * 4; ++x) acc[x] += w[i] * row[x];
+        }
+
+        uint8_t *out = dst + (size_t)y * dst_width * 4;
+        for (uint32_t x = 0; x < dst_width; ++x) {
+            const float *p = acc + x * 4;
+            float a = p[3];
+            if (a <= 0.0f) {
+                memset(out + x * 4, 0, 4);
+                continue;
+            }
+            for (int c = 0; c < 3; ++c) {
+                float v = p[c] / a + 0.5f;
+                out[x * 4 + c] = (uint8_t)(v > 255.0f ? 255.0f : v);
+            }
+            float alpha = a + 0.5f;
+            out[x * 4 + 3] = (uint8_t)(alpha > 255.0f ? 255.0f : alpha);
+        }
+    }
+
+    bfree(acc);
+    bfree(rows);
+    scale_taps_free(&tx);
+    scale_taps_free(&ty);
+    return dst;
+}
+
+uint32_t image_build_mips(uint8_t **levels, uint32_t width, uint32_t height, uint32_t max_levels)
+{
+    if (max_levels > IMAGE_SCALE_MAX_LEVELS) max_levels = IMAGE_SCALE_MAX_LEVELS;
+    uint32_t count = 1;
+    while (count < max_levels && (width > 1 || height > 1)) {
+        uint32_t next_width = width > 1 ? width / 2 : 1;
+        uint32_t next_height = height > 1 ? height / 2 : 1;
+        levels[count] = image_scale_area(levels[count - 1], width, height, next_width, next_height);
+        if (!levels[count]) break;
+        width = next_width;
+        height = next_height;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+// 自訂圖片的預先縮放與 mip 鏈產生（在背景工作執行緒上執行）
+// 像素為 8 位元 RGBA 或 BGRA（第四個通道必須是 alpha），以直接 alpha 儲存。
+// 縮小使用面積平均並以 alpha 加權顏色，透明邊緣不會混入黑邊。
+
+#define IMAGE_SCALE_MAX_LEVELS 16
+
+// 縮小到 dst_width x dst_height，回傳以 bmalloc 配置的像素（目標不可大於來源）
+uint8_t *image_scale_area(const uint8_t *src, uint32_t src_width, uint32_t src_height, uint32_t dst_width,
+                          uint32_t dst_height);
+
+// 以 levels[0]（width x height）產生縮小到 1x1 為止的 mip 鏈，新的層以 bmalloc 配置
+// 回傳總層數（含第 0 層）
+uint32_t image_build_mips(uint8_t **levels, uint32_t width, uint32_t height, uint32_t max_levels);
@@ -0,0 +1,129 @@
+#include "input_sampler.h"
+#include <obs-module.h>
+#include <util/platform.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+#define INPUT_SAMPLER_MASK (INPUT_SAMPLER_CAPACITY - 1)
+
+// 寫入一筆樣本；緩衝區已滿時捨棄
+static bool input_sampler_push(struct input_sampler *sampler, const struct cursor_sample *sample)
+{
+    // 以無號數運算，讓位置計數器溢位時自然回繞
+    unsigned long write_pos = (unsigned long)os_atomic_load_long(&sampler->write_pos);
+    unsigned long read_pos = (unsigned long)os_atomic_load_long(&sampler->read_pos);
+    if (write_pos - read_pos >= INPUT_SAMPLER_CAPACITY) return false;
+
+    sampler->samples[write_pos & INPUT_SAMPLER_MASK] = *sample;
+    // 樣本寫完後才發布寫入位置
+    os_atomic_set_long(&sampler->write_pos, (long)(write_pos + 1));
+    return true;
+}
+
+static void *input_sampler_thread(void *param)
+{
+    struct input_sampler *sampler = param;
+    os_set_thread_name("dr_cursor_tracker: input sampler");
+
+    bool has_last = false;
+    int32_t last_x = 0, last_y = 0;
+    bool raw_requested = false;
+    bool raw_active = false;
+    float pending_dx = 0.0f, pending_dy = 0.0f; // 尚未成功寫入的原始位移
+    uint64_t next_ns = os_gettime_ns();
+
+    while (!os_atomic_load_bool(&sampler->stop)) {
+        // 原始輸入的開關由取樣執行緒套用，後端只需處理單一執行緒的呼叫
+        bool want_raw = os_atomic_load_bool(&sampler->raw_input);
+        if (want_raw != raw_requested) {
+            raw_active = cursor_provider_set_raw_input(sampler->provider, want_raw);
+            raw_requested = want_raw;
+            pending_dx = pending_dy = 0.0f;
+        }
+
+        // 後端支援移動事件時改為事件驅動，取樣頻率只作為上限
+        if (cursor_provider_has_motion_events(sampler->provider) && has_last &&
+            !cursor_provider_wait_motion(sampler->provider, 100000000ULL)) {
+            continue; // 逾時：重新檢查是否要停止
+        }
+
+        float raw_dx = 0.0f, raw_dy = 0.0f;
+        if (raw_active && cursor_provider_consume_raw_delta(sampler->provider, &raw_dx, &raw_dy)) {
+            pending_dx += raw_dx;
+            pending_dy += raw_dy;
+        }
+
+        struct cursor_sample sample;
+        uint64_t now_ns = os_gettime_ns();
+        if (cursor_provider_get_position(sampler->provider, &sample.x, &sample.y)) {
+            bool moved = !has_last || sample.x != last_x || sample.y != last_y;
+            bool raw_moved = pending_dx != 0.0f || pending_dy != 0.0f;
+            // 游標被限制在畫面邊緣或遊戲鎖定游標時，只有原始位移會變化
+            if (moved || raw_moved) {
+                sample.timestamp = now_ns;
+                sample.raw_dx = pending_dx;
+                sample.raw_dy = pending_dy;
+                sample.raw = raw_active;
+                if (input_sampler_push(sampler, &sample)) {
+                    last_x = sample.x;
+                    last_y = sample.y;
+                    has_last = true;
+                    pending_dx = pending_dy = 0.0f;
+                }
+            }
+        }
+
+        long rate_hz = os_atomic_load_long(&sampler->rate_hz);
+        uint64_t interval_ns = 1000000000ULL / (uint64_t)(rate_hz > 0 ? rate_hz : 1000);
+        next_ns += interval_ns;
+        // 落後太多時重新對齊，避免追趕造成忙迴圈
+        if (next_ns + interval_ns < now_ns) next_ns = now_ns + interval_ns;
+        os_sleepto_ns(next_ns);
+    }
+    return NULL;
+}
+
+bool input_sampler_start(struct input_sampler *sampler, struct cursor_provider *provider, int rate_hz)
+{
+    sampler->provider = provider;
+    sampler->stop = false;
+    sampler->rate_hz = rate_hz;
+    sampler->write_pos = 0;
+    sampler->read_pos = 0;
+    sampler->thread_created = pthread_create(&sampler->thread, NULL, input_sampler_thread, sampler) == 0;
+    if (!sampler->thread_created) {
+        blog(LOG_WARNING, BLOG_PREFIX "無法建立滑鼠取樣執行緒，改為每幀取樣");
+    }
+    return sampler->thread_created;
+}
+
+void input_sampler_stop(struct input_sampler *sampler)
+{
+    if (!sampler->thread_created) return;
+    os_atomic_set_bool(&sampler->stop, true);
+    pthread_join(sampler->thread, NULL);
+    sampler->thread_created = false;
+}
+
+void input_sampler_set_raw_input(struct input_sampler *sampler, bool enable)
+{
+    os_atomic_set_bool(&sampler->raw_input, enable);
+}
+
+void input_sampler_set_rate(struct input_sampler *sampler, int rate_hz)
+{
+    os_atomic_set_long(&sampler->rate_hz, rate_hz);
+}
+
+size_t input_sampler_drain(struct input_sampler *sampler, struct cursor_sample *out, size_t max_samples)
+{
+    unsigned long read_pos = (unsigned long)os_atomic_load_long(&sampler->read_pos);
+    unsigned long write_pos = (unsigned long)os_atomic_load_long(&sampler->write_pos);
+    size_t count = 0;
+    while (read_pos != write_pos && count < max_samples) {
+        out[count++] = sampler->samples[read_pos & INPUT_SAMPLER_MASK];
+        read_pos++;
+    }
+    // 讀完樣本後才釋放空間給取樣執行緒
+    os_atomic_set_long(&sampler->read_pos, (long)read_pos);
+    return count;
+}
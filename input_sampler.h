@@ -0,0 +1,47 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <util/threading.h>
+#include "cursor_provider.h"
+
+// 環形緩衝區容量（必須是 2 的次方）
+#define INPUT_SAMPLER_CAPACITY 4096
+
+// 帶時間戳的滑鼠座標樣本
+struct cursor_sample {
+    int32_t x;
+    int32_t y;
+    uint64_t timestamp; // os_gettime_ns
+    float raw_dx;       // 自上一個樣本以來累積的原始相對位移（裝置單位）
+    float raw_dy;
+    bool raw;           // 原始輸入是否啟用；為 false 時 raw_dx / raw_dy 無意義
+};
+
+// 背景取樣執行緒
+// 以設定的頻率輪詢滑鼠位置（後端支援移動事件時改為事件驅動），僅在位置變化時寫入單一生產者/單一消費者的無鎖環形緩衝區。
+// 緩衝區滿時捨棄新樣本；由於樣本是絕對座標，只會損失解析度而不會遺失位移量。
+struct input_sampler {
+    struct cursor_provider *provider;
+    pthread_t thread;
+    bool thread_created;
+    volatile bool stop;
+    volatile long rate_hz;
+    volatile bool raw_input;
+    volatile long write_pos; // 僅由取樣執行緒寫入
+    volatile long read_pos;  // 僅由 tick 寫入
+    struct cursor_sample samples[INPUT_SAMPLER_CAPACITY];
+};
+
+bool input_sampler_start(struct input_sampler *sampler, struct cursor_provider *provider, int rate_hz);
+void input_sampler_stop(struct input_sampler *sampler);
+void input_sampler_set_rate(struct input_sampler *sampler, int rate_hz);
+void input_sampler_set_raw_input(struct input_sampler *sampler, bool enable);
+
+static inline bool input_sampler_running(const struct input_sampler *sampler)
+{
+    return sampler->thread_created;
+}
+
+// 取出自上次呼叫以來的所有樣本（依時間排序），回傳樣本數
+size_t input_sampler_drain(struct input_sampler *sampler, struct cursor_sample *out, size_t max_samples);
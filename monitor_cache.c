@@ -0,0 +1,101 @@
+#include "monitor_cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline bool rect_contains(const struct cursor_rect *r, int32_t x, int32_t y)
+{
+    return x >= r->left && x < r->right && y >= r->top && y < r->bottom;
+}
+
+static int compare_rects(const void *a, const void *b)
+{
+    const struct cursor_rect *ra = a;
+    const struct cursor_rect *rb = b;
+    if (ra->left != rb->left) return ra->left < rb->left ? -1 : 1;
+    if (ra->top != rb->top) return ra->top < rb->top ? -1 : 1;
+    return 0;
+}
+
+void monitor_cache_init(struct monitor_cache *cache)
+{
+    memset(cache, 0, sizeof(*cache));
+}
+
+void monitor_cache_set(struct monitor_cache *cache, const struct cursor_rect *rects, int count)
+{
+    if (count > MONITOR_CACHE_MAX) count = MONITOR_CACHE_MAX;
+    if (count < 0) count = 0;
+    memcpy(cache->monitors, rects, sizeof(struct cursor_rect) * count);
+    qsort(cache->monitors, count, sizeof(struct cursor_rect), compare_rects);
+    cache->count = count;
+    cache->last_hit = 0;
+
+    memset(&cache->desktop, 0, sizeof(cache->desktop));
+    for (int i = 0; i < count; ++i) {
+        const struct cursor_rect *r = &cache->monitors[i];
+        if (i == 0) {
+            cache->desktop = *r;
+            continue;
+        }
+        if (r->left < cache->desktop.left) cache->desktop.left = r->left;
+        if (r->top < cache->desktop.top) cache->desktop.top = r->top;
+        if (r->right > cache->desktop.right) cache->desktop.right = r->right;
+        if (r->bottom > cache->desktop.bottom) cache->desktop.bottom = r->bottom;
+    }
+    cache->valid = true;
+}
+
+bool monitor_cache_refresh(struct monitor_cache *cache, struct cursor_provider *provider)
+{
+    long generation = cursor_provider_monitor_generation(provider);
+    if (cache->valid && cache->generation == generation) return false;
+
+    struct cursor_rect rects[MONITOR_CACHE_MAX];
+    int count = cursor_provider_enum_monitors(provider, rects, MONITOR_CACHE_MAX);
+    monitor_cache_set(cache, rects, count);
+    cache->generation = generation;
+    return true;
+}
+
+bool monitor_cache_find(struct monitor_cache *cache, int32_t x, int32_t y, struct cursor_rect *rect)
+{
+    if (cache->count <= 0) return false;
+
+    // 絕大多數情況滑鼠仍在上次的螢幕上
+    if (rect_contains(&cache->monitors[cache->last_hit], x, y)) {
+        *rect = cache->monitors[cache->last_hit];
+        return true;
+    }
+
+    // 二分搜尋最後一個 left <= x 的螢幕，再往回檢查同一欄的螢幕
+    int lo = 0, hi = cache->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (cache->monitors[mid].left <= x) lo = mid + 1;
+        else hi = mid;
+    }
+    for (int i = lo - 1; i >= 0; --i) {
+        if (rect_contains(&cache->monitors[i], x, y)) {
+            cache->last_hit = i;
+            *rect = cache->monitors[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool monitor_cache_resolve(struct monitor_cache *cache, int monitor, int32_t x, int32_t y, struct cursor_rect *rect)
+{
+    if (cache->count <= 0) return false;
+
+    if (monitor == COORDINATE_MONITOR_DESKTOP) {
+        *rect = cache->desktop;
+        return true;
+    }
+    if (monitor >= 0 && monitor < cache->count) {
+        *rect = cache->monitors[monitor];
+        return true;
+    }
+    // 自動，或指定的螢幕已不存在
+    return monitor_cache_find(cache, x, y, rect);
+}
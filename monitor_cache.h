@@ -0,0 +1,35 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "cursor_provider.h"
+
+#define MONITOR_CACHE_MAX 16
+
+// 座標模式的螢幕選擇
+enum coordinate_monitor {
+    COORDINATE_MONITOR_AUTO = -1,    // 滑鼠所在的螢幕
+    COORDINATE_MONITOR_DESKTOP = -2, // 整個虛擬桌面
+    // 0 以上：依位置排序（由左至右、由上至下）後的指定螢幕
+};
+
+// 螢幕配置快取
+// 只在後端回報顯示設定變更（世代改變）時重新列舉；查詢先比對上次命中的螢幕，
+// 未命中再於依 left 排序的表中搜尋。
+struct monitor_cache {
+    struct cursor_rect monitors[MONITOR_CACHE_MAX];
+    struct cursor_rect desktop; // 所有螢幕的聯集
+    int count;
+    int last_hit;
+    long generation;
+    bool valid;
+};
+
+void monitor_cache_init(struct monitor_cache *cache);
+// 若後端世代改變或尚未建立則重新列舉，回傳是否有重建
+bool monitor_cache_refresh(struct monitor_cache *cache, struct cursor_provider *provider);
+// 以矩形陣列建立快取（會依位置排序）
+void monitor_cache_set(struct monitor_cache *cache, const struct cursor_rect *rects, int count);
+// 找出包含 (x, y) 的螢幕
+bool monitor_cache_find(struct monitor_cache *cache, int32_t x, int32_t y, struct cursor_rect *rect);
+// 依座標模式的螢幕設定取得映射範圍
+bool monitor_cache_resolve(struct monitor_cache *cache, int monitor, int32_t x, int32_t y, struct cursor_rect *rect);
@@ -0,0 +1,106 @@
+#include "motion.h"
+#include <math.h>
+
+void motion_init(struct motion_state *state, float offset_x, float offset_y)
+{
+    state->offset_x = offset_x;
+    state->offset_y = offset_y;
+    state->idle_time = 0.0f;
+    state->recenter_speed = 0.0f;
+    state->time_ns = 0;
+    state->accumulator_ns = 0;
+    state->started = false;
+}
+
+static inline float motion_curve(const struct response_curve *curve, float t)
+{
+    return curve ? response_curve_eval(curve, t) : t;
+}
+
+// 距離中心的比例（0 = 中心、1 = 最大偏移）
+static float motion_normalized_distance(const struct motion_state *state, const struct motion_params *params)
+{
+    float distance = sqrtf(state->offset_x * state->offset_x + state->offset_y * state->offset_y);
+    float normalized = params->max_offset > 0.0f ? distance / params->max_offset : 0.0f;
+    return normalized > 1.0f ? 1.0f : normalized;
+}
+
+static float motion_idle_boost(const struct motion_state *state, const struct motion_params *params)
+{
+    if (!params->idle_recenter) return 0.0f;
+    if (params->idle_delay > 0.0f && state->idle_time < params->idle_delay) return 0.0f;
+
+    // 加速值 = 目標加速值 * 進度；加速時間為 0 時直接使用最大進度
+    float progress = 1.0f;
+    if (params->idle_ramp > 0.0f) {
+        progress = (state->idle_time - params->idle_delay) / params->idle_ramp;
+        if (progress > 1.0f) progress = 1.0f;
+    }
+    return params->idle_boost * motion_curve(params->idle_curve, progress);
+}
+
+// 單一固定步長：依距離中心的比例與靜止加速計算回彈速度，並精確衰減一次
+void motion_step(struct motion_state *state, const struct motion_params *params)
+{
+    float normalized = motion_normalized_distance(state, params);
+
+    // 最終速度 = (中心速度 + 加速值) + ((外圍速度 + 加速值) - (中心速度 + 加速值)) * 曲線(距離)
+    float boost = motion_idle_boost(state, params);
+    float center = params->recenter_speed_center + boost;
+    float edge = params->recenter_speed_edge + boost;
+    float speed = center + (edge - center) * motion_curve(params->recenter_curve, normalized);
+    if (speed < 0.0f) speed = 0.0f;
+    state->recenter_speed = speed;
+
+    if (speed > 0.0f) {
+        float factor = expf(-speed * MOTION_STEP_SECONDS);
+        state->offset_x *= factor;
+        state->offset_y *= factor;
+    }
+    state->idle_time += MOTION_STEP_SECONDS;
+}
+
+void motion_advance(struct motion_state *state, const struct motion_params *params, uint64_t time_ns)
+{
+    if (!state->started) {
+        state->time_ns = time_ns;
+        state->started = true;
+        return;
+    }
+    if (time_ns <= state->time_ns) return;
+
+    uint64_t elapsed = time_ns - state->time_ns;
+    state->time_ns = time_ns;
+    // 長時間沒有推進（例如來源未啟用）時不逐步模擬，只累計靜止時間
+    if (elapsed > MOTION_MAX_CATCHUP_NS) {
+        state->idle_time += (float)(elapsed - MOTION_MAX_CATCHUP_NS) / 1000000000.0f;
+        elapsed = MOTION_MAX_CATCHUP_NS;
+    }
+
+    state->accumulator_ns += elapsed;
+    while (state->accumulator_ns >= MOTION_STEP_NS) {
+        motion_step(state, params);
+        state->accumulator_ns -= MOTION_STEP_NS;
+    }
+}
+
+void motion_apply_input(struct motion_state *state, const struct motion_params *params, float dx, float dy)
+{
+    if (dx == 0.0f && dy == 0.0f) return;
+    state->idle_time = 0.0f;
+
+    // 移速依目前距離中心的比例在中心與外圍之間內插
+    float t = motion_curve(params->move_curve, motion_normalized_distance(state, params));
+    float move_speed = params->move_speed_center + (params->move_speed_edge - params->move_speed_center) * t;
+    if (move_speed < 0.0f) move_speed = 0.0f;
+
+    state->offset_x += dx * params->sensitivity * move_speed;
+    state->offset_y += dy * params->sensitivity * move_speed;
+
+    // 限制最大偏移
+    float limit = params->max_offset;
+    if (state->offset_x > limit) state->offset_x = limit;
+    if (state->offset_x < -limit) state->offset_x = -limit;
+    if (state->offset_y > limit) state->offset_y = limit;
+    if (state->offset_y < -limit) state->offset_y = -limit;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "response_curve.h"
+
+// 移動模式的固定步長積分器（不依賴 OBS，可單獨編譯）
+// 回彈以固定的內部步長推進，未滿一步的時間留在累加器中；每一步以 exp(-speed * dt)
+// 精確衰減，因此輸出幀率（30 / 60 / 144 fps）或每幀的樣本分組都不會改變軌跡。
+// 時間一律以奈秒整數表示，避免浮點累加誤差。
+
+#define MOTION_STEP_NS 1000000ULL            // 內部步長：1 ms
+#define MOTION_MAX_CATCHUP_NS 1000000000ULL  // 單次推進最多模擬 1 秒，超過的部分只累計靜止時間
+#define MOTION_STEP_SECONDS ((float)MOTION_STEP_NS / 1000000000.0f)
+
+struct motion_params {
+    float sensitivity;
+    float move_speed_center;     // 準心中心移速倍率
+    float move_speed_edge;       // 準心外圍移速倍率
+    float recenter_speed_center; // 中心回彈速度（每秒衰減率）
+    float recenter_speed_edge;   // 外圍回彈速度
+    float max_offset;
+    bool idle_recenter;          // 是否啟用靜止回彈加速
+    float idle_delay;            // 開始加速前的延遲時間（秒）
+    float idle_ramp;             // 達到最大加速所需時間（秒）
+    float idle_boost;            // 最大加速值
+    // 反應曲線：輸入為距離中心的比例或加速進度，NULL 表示線性
+    const struct response_curve *move_curve;
+    const struct response_curve *recenter_curve;
+    const struct response_curve *idle_curve;
+};
+
+struct motion_state {
+    float offset_x;
+    float offset_y;
+    float idle_time;      // 最後一次移動後經過的時間（秒）
+    float recenter_speed; // 最近一步使用的回彈速度
+    uint64_t time_ns;     // 已積分到的時間點
+    uint64_t accumulator_ns; // 尚未滿一步的時間
+    bool started;
+};
+
+void motion_init(struct motion_state *state, float offset_x, float offset_y);
+// 將積分推進到 time_ns（早於目前時間點時忽略）
+void motion_advance(struct motion_state *state, const struct motion_params *params, uint64_t time_ns);
+// 單一固定步長的回彈（motion_advance 內部使用；批次模擬工具以此作為純量參考）
+void motion_step(struct motion_state *state, const struct motion_params *params);
+// 在目前時間點套用一次滑鼠位移
+void motion_apply_input(struct motion_state *state, const struct motion_params *params, float dx, float dy);
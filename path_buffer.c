@@ -0,0 +1,95 @@
+#include "path_buffer.h"
+#include <util/bmem.h>
+#include <string.h>
+
+bool path_buffer_init(struct path_buffer *buf, int capacity)
+{
+    memset(buf, 0, sizeof(*buf));
+    return path_buffer_resize(buf, capacity);
+}
+
+void path_buffer_free(struct path_buffer *buf)
+{
+    bfree(buf->x);
+    bfree(buf->y);
+    bfree(buf->timestamp);
+    memset(buf, 0, sizeof(*buf));
+}
+
+bool path_buffer_resize(struct path_buffer *buf, int capacity)
+{
+    if (capacity < 1) capacity = 1;
+    if (capacity == buf->capacity) return true;
+
+    float *new_x = bmalloc(sizeof(float) * capacity);
+    float *new_y = bmalloc(sizeof(float) * capacity);
+    uint64_t *new_ts = bmalloc(sizeof(uint64_t) * capacity);
+    if (!new_x || !new_y || !new_ts) {
+        bfree(new_x);
+        bfree(new_y);
+        bfree(new_ts);
+        return false;
+    }
+
+    // 只保留最新的點，並重新排列成從索引 0 開始
+    int keep = buf->count < capacity ? buf->count : capacity;
+    int skip = buf->count - keep;
+    for (int i = 0; i < keep; ++i) {
+        int idx = path_buffer_index(buf, skip + i);
+        new_x[i] = buf->x[idx];
+        new_y[i] = buf->y[idx];
+        new_ts[i] = buf->timestamp[idx];
+    }
+
+    bfree(buf->x);
+    bfree(buf->y);
+    bfree(buf->timestamp);
+    buf->x = new_x;
+    buf->y = new_y;
+    buf->timestamp = new_ts;
+    buf->capacity = capacity;
+    buf->head = 0;
+    buf->count = keep;
+    return true;
+}
+
+void path_buffer_clear(struct path_buffer *buf)
+{
+    buf->head = 0;
+    buf->count = 0;
+}
+
+void path_buffer_push(struct path_buffer *buf, float x, float y, uint64_t timestamp)
+{
+    if (buf->capacity <= 0) return;
+
+    int idx;
+    if (buf->count == buf->capacity) {
+        // 已滿：覆寫最舊的點
+        idx = buf->head;
+        buf->head = path_buffer_index(buf, 1);
+    } else {
+        idx = path_buffer_index(buf, buf->count);
+        buf->count++;
+    }
+    buf->x[idx] = x;
+    buf->y[idx] = y;
+    buf->timestamp[idx] = timestamp;
+}
+
+int path_buffer_expire(struct path_buffer *buf, uint64_t now_ns, uint64_t lifetime_ns)
+{
+    int removed = 0;
+    while (buf->count > 0) {
+        uint64_t ts = buf->timestamp[buf->head];
+        if (ts <= now_ns && now_ns - ts > lifetime_ns) {
+            buf->head = path_buffer_index(buf, 1);
+            buf->count--;
+            removed++;
+        } else {
+            break;
+        }
+    }
+    if (buf->count == 0) buf->head = 0;
+    return removed;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// 路徑點環形緩衝區
+// 以 SoA 方式分別存放 x / y / 時間戳，容量在建立時預先配置，
+// 新增與過期清理都不會在熱路徑上配置記憶體。
+struct path_buffer {
+    float *x;
+    float *y;
+    uint64_t *timestamp;
+    int capacity;
+    int head;  // 最舊點的索引
+    int count; // 目前存活的點數
+};
+
+bool path_buffer_init(struct path_buffer *buf, int capacity);
+void path_buffer_free(struct path_buffer *buf);
+// 調整容量，保留最新的點
+bool path_buffer_resize(struct path_buffer *buf, int capacity);
+void path_buffer_clear(struct path_buffer *buf);
+
+// 新增點；緩衝區已滿時覆寫最舊的點
+void path_buffer_push(struct path_buffer *buf, float x, float y, uint64_t timestamp);
+// 移除存活超過 lifetime_ns 的點（時間戳單調遞增，只需推進 head），回傳移除數量
+int path_buffer_expire(struct path_buffer *buf, uint64_t now_ns, uint64_t lifetime_ns);
+
+// 第 i 個存活點（0 = 最舊）在陣列中的索引
+static inline int path_buffer_index(const struct path_buffer *buf, int i)
+{
+    int idx = buf->head + i;
+    if (idx >= buf->capacity) idx -= buf->capacity;
+    return idx;
+}
+
+// 取得最新的點，緩衝區為空時回傳 false
+static inline bool path_buffer_last(const struct path_buffer *buf, float *x, float *y)
+{
+    if (buf->count <= 0) return false;
+    int idx = path_buffer_index(buf, buf->count - 1);
+    *x = buf->x[idx];
+    *y = buf->y[idx];
+    return true;
+}
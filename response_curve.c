@@ -0,0 +1,70 @@
+#include "response_curve.h"
+#include <stdio.h>
+
+// 單一座標軸的 cubic-bezier：B(t) = 3(1-t)^2 t p1 + 3(1-t) t^2 p2 + t^3
+static float bezier_axis(float p1, float p2, float t)
+{
+    float u = 1.0f - t;
+    return 3.0f * u * u * t * p1 + 3.0f * u * t * t * p2 + t * t * t;
+}
+
+static void bake_bezier(struct response_curve *curve, float x1, float y1, float x2, float y2)
+{
+    // x 控制點限制在 [0, 1]，確保 x(t) 單調遞增
+    x1 = x1 < 0.0f ? 0.0f : (x1 > 1.0f ? 1.0f : x1);
+    x2 = x2 < 0.0f ? 0.0f : (x2 > 1.0f ? 1.0f : x2);
+
+    for (int i = 0; i < RESPONSE_CURVE_LUT_SIZE; ++i) {
+        float x = (float)i / (float)(RESPONSE_CURVE_LUT_SIZE - 1);
+        // 二分搜尋 x(t) = x；只在烘焙時執行，不影響每個樣本的成本
+        float lo = 0.0f, hi = 1.0f, t = x;
+        for (int iter = 0; iter < 24; ++iter) {
+            t = (lo + hi) * 0.5f;
+            if (bezier_axis(x1, x2, t) < x) lo = t;
+            else hi = t;
+        }
+        curve->lut[i] = bezier_axis(y1, y2, t);
+    }
+    curve->lut[0] = 0.0f;
+    curve->lut[RESPONSE_CURVE_LUT_SIZE - 1] = 1.0f;
+}
+
+void response_curve_bake(struct response_curve *curve, int preset, const float *custom)
+{
+    switch (preset) {
+    case RESPONSE_CURVE_CONSTANT:
+        for (int i = 0; i < RESPONSE_CURVE_LUT_SIZE; ++i) curve->lut[i] = 0.0f;
+        break;
+    case RESPONSE_CURVE_EASE_IN:
+        bake_bezier(curve, 0.42f, 0.0f, 1.0f, 1.0f);
+        break;
+    case RESPONSE_CURVE_EASE_OUT:
+        bake_bezier(curve, 0.0f, 0.0f, 0.58f, 1.0f);
+        break;
+    case RESPONSE_CURVE_EASE_IN_OUT:
+        bake_bezier(curve, 0.42f, 0.0f, 0.58f, 1.0f);
+        break;
+    case RESPONSE_CURVE_CUSTOM:
+        if (custom) {
+            bake_bezier(curve, custom[0], custom[1], custom[2], custom[3]);
+            break;
+        }
+        // 沒有控制點時退回線性
+        /* fallthrough */
+    case RESPONSE_CURVE_LINEAR:
+    default:
+        for (int i = 0; i < RESPONSE_CURVE_LUT_SIZE; ++i) {
+            curve->lut[i] = (float)i / (float)(RESPONSE_CURVE_LUT_SIZE - 1);
+        }
+        break;
+    }
+}
+
+bool response_curve_parse_bezier(const char *text, float out[4])
+{
+    if (!text) return false;
+    float v[4];
+    if (sscanf(text, " %f , %f , %f , %f", &v[0], &v[1], &v[2], &v[3]) != 4) return false;
+    for (int i = 0; i < 4; ++i) out[i] = v[i];
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <stdbool.h>
+
+// 速度反應曲線（不依賴 OBS，可單獨編譯）
+// 曲線以 cubic-bezier 控制點（與 CSS 相同，端點固定為 (0,0) 與 (1,1)）或預設值定義，
+// 在設定變更時烘焙成固定大小的查表；每個樣本只需一次查表與線性內插，與曲線複雜度無關。
+
+#define RESPONSE_CURVE_LUT_SIZE 256
+
+enum response_curve_preset {
+    RESPONSE_CURVE_CONSTANT = 0, // 固定為起點值（例如只使用中心速度）
+    RESPONSE_CURVE_LINEAR = 1,
+    RESPONSE_CURVE_EASE_IN = 2,
+    RESPONSE_CURVE_EASE_OUT = 3,
+    RESPONSE_CURVE_EASE_IN_OUT = 4,
+    RESPONSE_CURVE_CUSTOM = 5,   // 使用自訂的 bezier 控制點
+};
+
+struct response_curve {
+    float lut[RESPONSE_CURVE_LUT_SIZE];
+};
+
+// 依預設值烘焙；custom 為 RESPONSE_CURVE_CUSTOM 使用的控制點 (x1, y1, x2, y2)，可為 NULL
+void response_curve_bake(struct response_curve *curve, int preset, const float *custom);
+// 解析 "x1, y1, x2, y2" 格式的控制點，失敗時回傳 false
+bool response_curve_parse_bezier(const char *text, float out[4]);
+
+// 查表並線性內插，t 會限制在 [0, 1]；回傳 0 = 起點值、1 = 終點值
+static inline float response_curve_eval(const struct response_curve *curve, float t)
+{
+    if (!(t > 0.0f)) return curve->lut[0];
+    if (t >= 1.0f) return curve->lut[RESPONSE_CURVE_LUT_SIZE - 1];
+    float pos = t * (float)(RESPONSE_CURVE_LUT_SIZE - 1);
+    int i = (int)pos;
+    float frac = pos - (float)i;
+    return curve->lut[i] + (curve->lut[i + 1] - curve->lut[i]) * frac;
+}
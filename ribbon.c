@@ -0,0 +1,352 @@
+#include "ribbon.h"
+#include <util/bmem.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+bool ribbon_init(struct ribbon *ribbon, int max_points)
+{
+    memset(ribbon, 0, sizeof(*ribbon));
+    return ribbon_resize(ribbon, max_points);
+}
+
+void ribbon_free(struct ribbon *ribbon)
+{
+    bfree(ribbon->samples);
+    memset(ribbon, 0, sizeof(*ribbon));
+}
+
+bool ribbon_resize(struct ribbon *ribbon, int max_points)
+{
+    if (max_points < 1) max_points = 1;
+    int capacity = max_points * RIBBON_SUBDIVISIONS;
+    if (capacity != ribbon->capacity) {
+        struct ribbon_sample *samples = bmalloc(sizeof(struct ribbon_sample) * capacity);
+        if (!samples) return false;
+        bfree(ribbon->samples);
+        ribbon->samples = samples;
+        ribbon->capacity = capacity;
+    }
+    ribbon_clear(ribbon);
+    return true;
+}
+
+void ribbon_clear(struct ribbon *ribbon)
+{
+    ribbon->head = 0;
+    ribbon->count = 0;
+    ribbon->point_count = 0;
+    ribbon->settled = 0;
+    ribbon->has_candidate = false;
+}
+
+bool ribbon_last_point(const struct ribbon *ribbon, float *x, float *y)
+{
+    if (ribbon->point_count <= 0) return false;
+    const struct ribbon_point *p = &ribbon->points[ribbon->point_count - 1];
+    *x = p->x;
+    *y = p->y;
+    return true;
+}
+
+static inline int ribbon_index(const struct ribbon *ribbon, int i)
+{
+    int idx = ribbon->head + i;
+    if (idx >= ribbon->capacity) idx -= ribbon->capacity;
+    return idx;
+}
+
+// 細分 p1 → p2 的 Catmull-Rom 曲線段（p0、p3 為相鄰控制點），不含 p2 本身
+static int ribbon_tessellate(const struct ribbon_point *p0, const struct ribbon_point *p1,
+                             const struct ribbon_point *p2, const struct ribbon_point *p3,
+                             struct ribbon_sample *out)
+{
+    float dx = p2->x - p1->x, dy = p2->y - p1->y;
+    float length = sqrtf(dx * dx + dy * dy);
+    uint64_t dt = p2->timestamp > p1->timestamp ? p2->timestamp - p1->timestamp : 0;
+    float speed = dt > 0 ? length / ((float)dt / 1000000000.0f) : 0.0f;
+
+    // 多項式係數：p(t) = a + b t + c t^2 + d t^3
+    float bx = 0.5f * (p2->x - p0->x), by = 0.5f * (p2->y - p0->y);
+    float cx = 0.5f * (2.0f * p0->x - 5.0f * p1->x + 4.0f * p2->x - p3->x);
+    float cy = 0.5f * (2.0f * p0->y - 5.0f * p1->y + 4.0f * p2->y - p3->y);
+    float ex = 0.5f * (-p0->x + 3.0f * p1->x - 3.0f * p2->x + p3->x);
+    float ey = 0.5f * (-p0->y + 3.0f * p1->y - 3.0f * p2->y + p3->y);
+
+    for (int s = 0; s < RIBBON_SUBDIVISIONS; ++s) {
+        float t = (float)s / (float)RIBBON_SUBDIVISIONS;
+        struct ribbon_sample *o = &out[s];
+        o->x = p1->x + (bx + (cx + ex * t) * t) * t;
+        o->y = p1->y + (by + (cy + ey * t) * t) * t;
+
+        // 切線轉 90 度得到法向量；退化時沿用弦的方向
+        float tx = bx + (2.0f * cx + 3.0f * ex * t) * t;
+        float ty = by + (2.0f * cy + 3.0f * ey * t) * t;
+        float tl = sqrtf(tx * tx + ty * ty);
+        if (tl < 1e-4f) {
+            tx = dx;
+            ty = dy;
+            tl = length;
+        }
+        o->nx = tl > 0.0f ? -ty / tl : 0.0f;
+        o->ny = tl > 0.0f ? tx / tl : 1.0f;
+        o->speed = speed;
+        o->timestamp = p1->timestamp + (uint64_t)((double)dt * (double)t);
+    }
+    return RIBBON_SUBDIVISIONS;
+}
+
+// 從最舊端移除 n 個取樣點，並調整簡化狀態
+static void ribbon_drop_oldest(struct ribbon *ribbon, int n)
+{
+    ribbon->head = ribbon_index(ribbon, n);
+    ribbon->count -= n;
+    if (ribbon->count == 0) ribbon->head = 0;
+    if (n < ribbon->settled) {
+        ribbon->settled -= n;
+    } else {
+        // 錨點已被移除：剩下的點（含候選點）重新從第一個點開始簡化
+        ribbon->settled = 0;
+        ribbon->has_candidate = false;
+    }
+}
+
+static void ribbon_push_sample(struct ribbon *ribbon, const struct ribbon_sample *sample)
+{
+    int idx;
+    if (ribbon->count == ribbon->capacity) {
+        // 已滿：覆寫最舊的取樣點
+        ribbon_drop_oldest(ribbon, 1);
+        idx = ribbon_index(ribbon, ribbon->count);
+        ribbon->count++;
+    } else {
+        idx = ribbon_index(ribbon, ribbon->count);
+        ribbon->count++;
+    }
+    ribbon->samples[idx] = *sample;
+    ribbon->total_samples++;
+}
+
+void ribbon_add_point(struct ribbon *ribbon, float x, float y, uint64_t timestamp)
+{
+    struct ribbon_point p = {x, y, timestamp};
+
+    // 有兩個以上的控制點時，倒數第二個到最後一個的曲線段已可確定
+    if (ribbon->point_count >= 2) {
+        const struct ribbon_point *p1 = &ribbon->points[ribbon->point_count - 2];
+        const struct ribbon_point *p2 = &ribbon->points[ribbon->point_count - 1];
+        const struct ribbon_point *p0 = ribbon->point_count >= 3 ? &ribbon->points[0] : p1;
+        struct ribbon_sample samples[RIBBON_SUBDIVISIONS];
+        int n = ribbon_tessellate(p0, p1, p2, &p, samples);
+        for (int i = 0; i < n; ++i) ribbon_push_sample(ribbon, &samples[i]);
+    }
+
+    if (ribbon->point_count == 3) {
+        ribbon->points[0] = ribbon->points[1];
+        ribbon->points[1] = ribbon->points[2];
+        ribbon->point_count = 2;
+    }
+    ribbon->points[ribbon->point_count++] = p;
+}
+
+void ribbon_expire(struct ribbon *ribbon, uint64_t now_ns, uint64_t lifetime_ns)
+{
+    int expired = 0;
+    while (expired < ribbon->count) {
+        uint64_t ts = ribbon->samples[ribbon_index(ribbon, expired)].timestamp;
+        if (ts > now_ns || now_ns - ts <= lifetime_ns) break;
+        expired++;
+    }
+    if (expired > 0) ribbon_drop_oldest(ribbon, expired);
+
+    // 最新的控制點也過期時，下一次移動從新的起點開始，避免連回很久以前的位置
+    if (ribbon->point_count > 0) {
+        uint64_t ts = ribbon->points[ribbon->point_count - 1].timestamp;
+        if (ts <= now_ns && now_ns - ts > lifetime_ns) ribbon->point_count = 0;
+    }
+}
+
+// 速度對應的寬度（尚未套用年齡收窄）
+static inline float ribbon_speed_width(const struct ribbon_style *style, float speed)
+{
+    float speed_ratio = style->full_speed > 0.0f ? speed / style->full_speed : 1.0f;
+    if (speed_ratio > 1.0f) speed_ratio = 1.0f;
+    return style->width * (RIBBON_MIN_WIDTH + (1.0f - RIBBON_MIN_WIDTH) * speed_ratio);
+}
+
+// 方向角相對基準角度的差，範圍 (-π, π]
+static inline float ribbon_relative_angle(float angle, float ref)
+{
+    float d = angle - ref;
+    if (d > (float)M_PI) d -= 2.0f * (float)M_PI;
+    if (d <= -(float)M_PI) d += 2.0f * (float)M_PI;
+    return d;
+}
+
+// 開始以新的錨點累積省略點
+static void ribbon_begin_run(struct ribbon *ribbon, float anchor_width)
+{
+    ribbon->wedge_set = false;
+    ribbon->wedge_lo = -(float)M_PI;
+    ribbon->wedge_hi = (float)M_PI;
+    ribbon->run_max_dist = 0.0f;
+    ribbon->run_min_width = anchor_width;
+    ribbon->run_max_width = anchor_width;
+}
+
+// 把 q 加入「可被省略」的限制：從錨點出發的線段方向必須讓 q 落在容差內
+static void ribbon_constrain(struct ribbon *ribbon, const struct ribbon_sample *anchor,
+                             const struct ribbon_sample *q, float width, float tolerance)
+{
+    float dx = q->x - anchor->x, dy = q->y - anchor->y;
+    float dist = sqrtf(dx * dx + dy * dy);
+    if (dist > ribbon->run_max_dist) ribbon->run_max_dist = dist;
+    if (width < ribbon->run_min_width) ribbon->run_min_width = width;
+    if (width > ribbon->run_max_width) ribbon->run_max_width = width;
+    if (dist <= tolerance) return; // 離錨點夠近，任何方向都在容差內
+
+    float half = asinf(tolerance / dist);
+    float angle = atan2f(dy, dx);
+    if (!ribbon->wedge_set) {
+        ribbon->wedge_set = true;
+        ribbon->wedge_ref = angle;
+        ribbon->wedge_lo = -half;
+        ribbon->wedge_hi = half;
+        return;
+    }
+    float rel = ribbon_relative_angle(angle, ribbon->wedge_ref);
+    if (rel - half > ribbon->wedge_lo) ribbon->wedge_lo = rel - half;
+    if (rel + half < ribbon->wedge_hi) ribbon->wedge_hi = rel + half;
+}
+
+// 錨點到 p 的線段能否取代目前累積的所有省略點與候選點
+static bool ribbon_run_accepts(const struct ribbon *ribbon, const struct ribbon_sample *anchor,
+                               const struct ribbon_sample *p, float width, float tolerance)
+{
+    float dx = p->x - anchor->x, dy = p->y - anchor->y;
+    float dist = sqrtf(dx * dx + dy * dy);
+    // 折返時省略點會投影到線段之外
+    if (dist < ribbon->run_max_dist) return false;
+    // 寬度變化超過容差時保留中間點
+    float min_w = width < ribbon->run_min_width ? width : ribbon->run_min_width;
+    float max_w = width > ribbon->run_max_width ? width : ribbon->run_max_width;
+    if (max_w - min_w > tolerance) return false;
+    if (!ribbon->wedge_set) return true;
+
+    float rel = ribbon_relative_angle(atan2f(dy, dx), ribbon->wedge_ref);
+    return rel >= ribbon->wedge_lo && rel <= ribbon->wedge_hi;
+}
+
+int ribbon_simplify(struct ribbon *ribbon, const struct ribbon_style *style, uint64_t now_ns, float tolerance)
+{
+    if (tolerance <= 0.0f) return 0;
+
+    // write：下一個輸出位置；read：下一個待處理的取樣點（邏輯索引）
+    int write = ribbon->settled + (ribbon->has_candidate ? 1 : 0);
+    int read = write;
+    while (read < ribbon->count) {
+        const struct ribbon_sample p = ribbon->samples[ribbon_index(ribbon, read)];
+        if (p.timestamp > now_ns || now_ns - p.timestamp <= RIBBON_FRESH_NS) break;
+        read++;
+
+        float width = ribbon_speed_width(style, p.speed);
+        if (ribbon->settled == 0) {
+            // 第一個點直接成為錨點
+            ribbon->samples[ribbon_index(ribbon, write++)] = p;
+            ribbon->settled = 1;
+            ribbon->has_candidate = false;
+            ribbon_begin_run(ribbon, width);
+            continue;
+        }
+
+        const struct ribbon_sample *anchor = &ribbon->samples[ribbon_index(ribbon, ribbon->settled - 1)];
+        if (ribbon->has_candidate && ribbon_run_accepts(ribbon, anchor, &p, width, tolerance)) {
+            // 省略候選點，由 p 取代
+            ribbon->samples[ribbon_index(ribbon, write - 1)] = p;
+            ribbon->removed_samples++;
+        } else {
+            if (ribbon->has_candidate) {
+                // 候選點必須保留，成為新的錨點
+                const struct ribbon_sample *kept = &ribbon->samples[ribbon_index(ribbon, ribbon->settled)];
+                ribbon->settled++;
+                ribbon_begin_run(ribbon, ribbon_speed_width(style, kept->speed));
+                anchor = kept;
+            }
+            ribbon->samples[ribbon_index(ribbon, write++)] = p;
+            ribbon->has_candidate = true;
+        }
+        ribbon_constrain(ribbon, anchor, &p, width, tolerance);
+    }
+
+    // 把尚未處理的新鮮區往前搬，補上被省略的空位
+    int removed = read - write;
+    if (removed > 0) {
+        for (int i = read; i < ribbon->count; ++i) {
+            ribbon->samples[ribbon_index(ribbon, write++)] = ribbon->samples[ribbon_index(ribbon, i)];
+        }
+        ribbon->count -= removed;
+    }
+    return removed;
+}
+
+// 把一個取樣點展開成三角形帶的左右兩個頂點
+static inline size_t ribbon_emit(const struct ribbon_sample *s, const struct ribbon_style *style, uint64_t now_ns,
+                                 struct vec3 *pos, uint32_t *colors, size_t n)
+{
+    uint64_t age = now_ns > s->timestamp ? now_ns - s->timestamp : 0;
+    float life = style->lifetime_ns > 0 ? 1.0f - (float)age / (float)style->lifetime_ns : 0.0f;
+    if (life < 0.0f) life = 0.0f;
+
+    // 寬度隨速度增加、隨年齡收窄
+    float half = 0.5f * ribbon_speed_width(style, s->speed) * life;
+
+    uint32_t c = style->rgb | ((uint32_t)(life * 255.0f + 0.5f) << 24);
+    vec3_set(&pos[n], s->x + s->nx * half, s->y + s->ny * half, 0.0f);
+    vec3_set(&pos[n + 1], s->x - s->nx * half, s->y - s->ny * half, 0.0f);
+    colors[n] = c;
+    colors[n + 1] = c;
+    return n + 2;
+}
+
+size_t ribbon_build(const struct ribbon *ribbon, const struct ribbon_style *style, float head_x, float head_y,
+                    uint64_t now_ns, struct vec3 *pos, uint32_t *colors, size_t max_vertices)
+{
+    size_t n = 0;
+
+    // 已確定的曲線段：只依年齡展開，不重新細分
+    for (int i = 0; i < ribbon->count && n + 2 <= max_vertices; ++i) {
+        n = ribbon_emit(&ribbon->samples[ribbon_index(ribbon, i)], style, now_ns, pos, colors, n);
+    }
+    if (ribbon->point_count == 0) return n;
+
+    // 未確定的部分：最後兩個控制點之間，以及最後一個控制點到目前位置
+    struct ribbon_point head = {head_x, head_y, now_ns};
+    const struct ribbon_point *last = &ribbon->points[ribbon->point_count - 1];
+    struct ribbon_sample samples[RIBBON_SUBDIVISIONS * 2 + 1];
+    int count = 0;
+    if (ribbon->point_count >= 2) {
+        const struct ribbon_point *p1 = &ribbon->points[ribbon->point_count - 2];
+        const struct ribbon_point *p0 = ribbon->point_count >= 3 ? &ribbon->points[0] : p1;
+        count += ribbon_tessellate(p0, p1, last, &head, samples);
+    }
+    if (head.x != last->x || head.y != last->y) {
+        const struct ribbon_point *p0 = ribbon->point_count >= 2 ? &ribbon->points[ribbon->point_count - 2] : last;
+        count += ribbon_tessellate(p0, last, &head, &head, samples + count);
+    }
+    // 以最後一個取樣點的方向補上終點
+    struct ribbon_sample end = {head.x, head.y, 0.0f, 1.0f, 0.0f, now_ns};
+    if (count > 0) {
+        end.nx = samples[count - 1].nx;
+        end.ny = samples[count - 1].ny;
+        end.speed = samples[count - 1].speed;
+    }
+    samples[count++] = end;
+
+    for (int i = 0; i < count && n + 2 <= max_vertices; ++i) {
+        n = ribbon_emit(&samples[i], style, now_ns, pos, colors, n);
+    }
+    return n;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <graphics/vec3.h>
+
+// 緞帶軌跡
+// 路徑控制點以 Catmull-Rom 曲線平滑後細分成取樣點，整條軌跡以單一三角形帶繪製。
+// 控制點確定後（已有下一個控制點）其曲線段只細分一次並快取在環形緩衝區；
+// 每幀只重新細分連接到準心目前位置的最後兩段，其餘只依年齡與速度展開成頂點。
+// 離開新鮮區（最近 RIBBON_FRESH_NS）的取樣點會以容差逐步簡化，
+// 合併幾乎共線且寬度相近的點，讓長存活時間下的頂點數維持在可控範圍。
+
+#define RIBBON_SUBDIVISIONS 8   // 每段曲線的取樣數
+#define RIBBON_MIN_WIDTH 0.25f  // 靜止時的寬度比例
+#define RIBBON_FRESH_NS 250000000ULL // 保持完整細節的最近時間範圍
+#define RIBBON_TAIL_VERTICES ((2 * RIBBON_SUBDIVISIONS + 1) * 2) // 未確定曲線段的頂點數上限
+
+// 細分後的取樣點：位置、單位法向量與移動速度
+struct ribbon_sample {
+    float x;
+    float y;
+    float nx;
+    float ny;
+    float speed;        // 像素 / 秒
+    uint64_t timestamp;
+};
+
+struct ribbon_point {
+    float x;
+    float y;
+    uint64_t timestamp;
+};
+
+struct ribbon {
+    struct ribbon_sample *samples; // 已確定曲線段的取樣點（環形緩衝區）
+    int capacity;
+    int head;
+    int count;
+    struct ribbon_point points[3]; // 最近的三個控制點（由舊到新）
+    int point_count;
+
+    // 增量簡化狀態：[0, settled) 已確定保留，settled 位置可能是尚未確定的候選點
+    int settled;
+    bool has_candidate;
+    // 從錨點（最後一個保留點）出發、讓所有省略點都落在容差內的方向範圍
+    bool wedge_set;
+    float wedge_ref;   // 方向範圍的基準角度
+    float wedge_lo;    // 相對基準角度的下限 / 上限
+    float wedge_hi;
+    float run_max_dist; // 省略點到錨點的最遠距離
+    float run_min_width; // 錨點之後各點的寬度範圍
+    float run_max_width;
+
+    // 統計
+    uint64_t total_samples;   // 產生的取樣點總數
+    uint64_t removed_samples; // 被簡化移除的取樣點數
+};
+
+struct ribbon_style {
+    float width;         // 最大寬度（像素）
+    float full_speed;    // 達到最大寬度的速度（像素 / 秒）
+    uint64_t lifetime_ns;
+    uint32_t rgb;        // 頂點顏色（不含透明度）
+};
+
+bool ribbon_init(struct ribbon *ribbon, int max_points);
+void ribbon_free(struct ribbon *ribbon);
+// 依控制點上限調整容量（會清除現有軌跡）
+bool ribbon_resize(struct ribbon *ribbon, int max_points);
+void ribbon_clear(struct ribbon *ribbon);
+
+// 取得最新的控制點，沒有時回傳 false
+bool ribbon_last_point(const struct ribbon *ribbon, float *x, float *y);
+// 新增控制點；前一段曲線因此確定並被細分
+void ribbon_add_point(struct ribbon *ribbon, float x, float y, uint64_t timestamp);
+// 移除過期的取樣點
+void ribbon_expire(struct ribbon *ribbon, uint64_t now_ns, uint64_t lifetime_ns);
+
+// 簡化新鮮區以外的取樣點，位置與寬度誤差不超過 tolerance 像素；回傳移除數量
+int ribbon_simplify(struct ribbon *ribbon, const struct ribbon_style *style, uint64_t now_ns, float tolerance);
+// 被簡化移除的取樣點比例（0 ~ 1）
+static inline float ribbon_reduction_ratio(const struct ribbon *ribbon)
+{
+    if (ribbon->total_samples == 0) return 0.0f;
+    return (float)((double)ribbon->removed_samples / (double)ribbon->total_samples);
+}
+
+// 可容納的最大頂點數（含連接到目前位置的部分）
+static inline size_t ribbon_max_vertices(const struct ribbon *ribbon)
+{
+    return (size_t)ribbon->capacity * 2 + RIBBON_TAIL_VERTICES;
+}
+
+// 以 (head_x, head_y) 作為目前準心位置展開三角形帶頂點，回傳頂點數
+size_t ribbon_build(const struct ribbon *ribbon, const struct ribbon_style *style, float head_x, float head_y,
+                    uint64_t now_ns, struct vec3 *pos, uint32_t *colors, size_t max_vertices);
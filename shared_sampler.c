@@ -0,0 +1,149 @@
+#include "shared_sampler.h"
+#include <obs-module.h>
+#include <util/platform.h>
+#include <util/threading.h>
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+static pthread_mutex_t g_mutex;
+static bool g_mutex_initialized = false;
+static long g_refs = 0;
+static struct shared_sampler_client *g_clients = NULL;
+static struct cursor_provider g_provider;
+static struct input_sampler *g_sampler = NULL; // 環形緩衝區較大，改放在堆積上
+static struct monitor_cache g_monitors;
+
+// 幀快照：只由圖形執行緒存取
+static struct cursor_sample *g_frame_samples = NULL;
+static struct sampler_frame g_frame;
+static bool g_frame_valid = false;
+
+void shared_sampler_init(void)
+{
+    if (g_mutex_initialized) return;
+    g_mutex_initialized = pthread_mutex_init(&g_mutex, NULL) == 0;
+}
+
+void shared_sampler_free(void)
+{
+    if (!g_mutex_initialized) return;
+    if (g_refs > 0) {
+        blog(LOG_WARNING, BLOG_PREFIX "卸載時仍有 %ld 個取樣器參照", g_refs);
+    }
+    pthread_mutex_destroy(&g_mutex);
+    g_mutex_initialized = false;
+}
+
+// 依所有實例的需求更新取樣頻率與原始輸入（需持有 g_mutex）
+static void shared_sampler_apply_locked(void)
+{
+    int rate_hz = 0;
+    bool raw_input = false;
+    for (struct shared_sampler_client *c = g_clients; c; c = c->next) {
+        if (c->rate_hz > rate_hz) rate_hz = c->rate_hz;
+        raw_input = raw_input || c->raw_input;
+    }
+    if (rate_hz <= 0) rate_hz = 1000;
+    input_sampler_set_rate(g_sampler, rate_hz);
+    input_sampler_set_raw_input(g_sampler, raw_input);
+}
+
+static void shared_sampler_start_locked(int rate_hz)
+{
+    g_sampler = bzalloc(sizeof(struct input_sampler));
+    g_frame_samples = bzalloc(sizeof(struct cursor_sample) * INPUT_SAMPLER_CAPACITY);
+    cursor_provider_init(&g_provider);
+    monitor_cache_init(&g_monitors);
+    g_frame_valid = false;
+    input_sampler_set_raw_input(g_sampler, false);
+    input_sampler_start(g_sampler, &g_provider, rate_hz);
+}
+
+static void shared_sampler_stop_locked(void)
+{
+    // 先停止取樣執行緒，再釋放後端
+    input_sampler_stop(g_sampler);
+    cursor_provider_free(&g_provider);
+    bfree(g_sampler);
+    g_sampler = NULL;
+    bfree(g_frame_samples);
+    g_frame_samples = NULL;
+    g_frame_valid = false;
+}
+
+struct shared_sampler_client *shared_sampler_acquire(int rate_hz, bool raw_input)
+{
+    struct shared_sampler_client *client = bzalloc(sizeof(struct shared_sampler_client));
+    client->rate_hz = rate_hz;
+    client->raw_input = raw_input;
+
+    pthread_mutex_lock(&g_mutex);
+    if (g_refs++ == 0) shared_sampler_start_locked(rate_hz);
+    client->next = g_clients;
+    g_clients = client;
+    shared_sampler_apply_locked();
+    pthread_mutex_unlock(&g_mutex);
+    return client;
+}
+
+void shared_sampler_update(struct shared_sampler_client *client, int rate_hz, bool raw_input)
+{
+    if (!client) return;
+    pthread_mutex_lock(&g_mutex);
+    client->rate_hz = rate_hz;
+    client->raw_input = raw_input;
+    shared_sampler_apply_locked();
+    pthread_mutex_unlock(&g_mutex);
+}
+
+void shared_sampler_release(struct shared_sampler_client *client)
+{
+    if (!client) return;
+    pthread_mutex_lock(&g_mutex);
+    struct shared_sampler_client **link = &g_clients;
+    while (*link && *link != client) link = &(*link)->next;
+    if (*link) *link = client->next;
+
+    if (--g_refs == 0) {
+        shared_sampler_stop_locked();
+    } else {
+        shared_sampler_apply_locked();
+    }
+    pthread_mutex_unlock(&g_mutex);
+    bfree(client);
+}
+
+const struct sampler_frame *shared_sampler_get_frame(void)
+{
+    // 同一幀內的其他實例直接沿用快照
+    uint64_t frame_time = obs_get_video_frame_time();
+    if (g_frame_valid && g_frame.frame_time == frame_time) return &g_frame;
+
+    uint64_t now_ns = os_gettime_ns();
+    // 取出取樣執行緒自上一幀以來的所有樣本；執行緒不可用時退回每幀取樣一次
+    size_t count = input_sampler_drain(g_sampler, g_frame_samples, INPUT_SAMPLER_CAPACITY);
+    if (count == 0 && !input_sampler_running(g_sampler)) {
+        struct cursor_sample *s = &g_frame_samples[0];
+        if (cursor_provider_get_position(&g_provider, &s->x, &s->y)) {
+            s->timestamp = now_ns;
+            s->raw_dx = s->raw_dy = 0.0f;
+            s->raw = false;
+            count = 1;
+        }
+    }
+
+    // 只有顯示設定變更時才重新列舉螢幕
+    monitor_cache_refresh(&g_monitors, &g_provider);
+
+    g_frame.frame_time = frame_time;
+    g_frame.now_ns = now_ns;
+    g_frame.count = count;
+    g_frame.samples = g_frame_samples;
+    g_frame_valid = true;
+    return &g_frame;
+}
+
+struct monitor_cache *shared_sampler_monitors(void)
+{
+    return &g_monitors;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "input_sampler.h"
+#include "monitor_cache.h"
+
+// 全模組共用的滑鼠取樣器
+// 所有來源實例共用同一個平台後端與取樣執行緒；每一幀由第一個 tick 的實例取出樣本，
+// 建立唯讀快照供其他實例直接讀取，讓每個實例的 tick 成本不隨實例數量增加。
+// 取樣頻率取所有實例設定的最大值，任一實例需要原始輸入時即啟用。
+
+// 單一視訊幀的樣本快照（只在圖形執行緒上讀寫）
+struct sampler_frame {
+    uint64_t frame_time; // obs_get_video_frame_time
+    uint64_t now_ns;     // 建立快照時的 os_gettime_ns
+    size_t count;
+    const struct cursor_sample *samples;
+};
+
+// 每個來源實例持有的取樣需求
+struct shared_sampler_client {
+    int rate_hz;
+    bool raw_input;
+    struct shared_sampler_client *next;
+};
+
+void shared_sampler_init(void);
+void shared_sampler_free(void);
+
+// 第一個實例取得時建立後端與取樣執行緒，最後一個釋放時停止
+struct shared_sampler_client *shared_sampler_acquire(int rate_hz, bool raw_input);
+void shared_sampler_update(struct shared_sampler_client *client, int rate_hz, bool raw_input);
+void shared_sampler_release(struct shared_sampler_client *client);
+
+// 取得本幀的樣本快照；必須在 video_tick 中呼叫
+const struct sampler_frame *shared_sampler_get_frame(void);
+// 共用的螢幕配置快取；由 shared_sampler_get_frame 更新
+struct monitor_cache *shared_sampler_monitors(void);
@@ -0,0 +1,622 @@
+#include "texture_worker.h"
+#include "circle_raster.h"
+#include "image_scale.h"
+#include <graphics/image-file.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include <sys/stat.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define BLOG_PREFIX "[crosshair_box] "
+
+enum texture_job_type {
+    TEXTURE_JOB_CIRCLE,
+    TEXTURE_JOB_IMAGE,
+};
+
+enum texture_job_state {
+    TEXTURE_JOB_PENDING = 0,
+    TEXTURE_JOB_DONE,
+    TEXTURE_JOB_FAILED,
+    TEXTURE_JOB_CANCELED,
+};
+
+// 工作由快取項目與佇列各持有一個參照，最後一個釋放者負責清理
+struct texture_job {
+    volatile long refs;
+    volatile long state;
+    enum texture_job_type type;
+
+    // 參數
+    int radius;
+    int thickness;
+    uint32_t color;
+    float alpha;
+    char *path;
+    float scale;
+
+    // 結果（CPU 資料）：levels[0] 為原尺寸，其後為 mip 鏈
+    uint8_t *levels[IMAGE_SCALE_MAX_LEVELS];
+    uint32_t level_count;
+    uint32_t width;
+    uint32_t height;
+    enum gs_color_format format;
+    float baked_scale; // 已預先縮放的比例（1 = 原尺寸）
+    gs_image_file4_t image;
+    bool has_image;
+
+    struct texture_job *next;
+};
+
+enum texture_entry_state {
+    TEXTURE_ENTRY_LOADING = 0,
+    TEXTURE_ENTRY_READY,
+    TEXTURE_ENTRY_FAILED,
+};
+
+struct texture_entry {
+    uint64_t key;
+    uint64_t path_key;         // 圖片路徑（不含檔案版本）；圓形紋理為 0
+    uint64_t version;          // 檔案的修改時間與大小
+    bool stale;                // 檔案已被覆寫，沒有參照後立即釋放
+    long refs;                 // 插槽參照數
+    enum texture_entry_state state;
+    struct texture_job *job;   // 載入中的工作
+    gs_texture_t *texture;
+    float baked_scale;         // 紋理相對原圖已縮放的比例
+    size_t bytes;
+    uint64_t last_used;        // 最後一次被繪製或請求的時間（LRU）
+    struct texture_entry *next;
+};
+
+// 工作佇列
+static pthread_mutex_t g_queue_mutex;
+static os_sem_t *g_queue_sem = NULL;
+static struct texture_job *g_queue_head = NULL;
+static struct texture_job *g_queue_tail = NULL;
+static pthread_t g_thread;
+static bool g_thread_created = false;
+static volatile bool g_stopping = false;
+
+// 紋理快取與所有插槽共用一把鎖。持有此鎖時不可進入圖形上下文：
+// 圖形執行緒會在圖形上下文內取得此鎖，反向的順序會造成死結。
+static pthread_mutex_t g_cache_mutex;
+static bool g_cache_initialized = false;
+static struct texture_entry *g_entries = NULL;
+static size_t g_cache_bytes = 0;
+static uint64_t g_cache_hits = 0;
+static uint64_t g_cache_misses = 0;
+
+static void texture_job_release(struct texture_job *job)
+{
+    if (!job || os_atomic_dec_long(&job->refs) > 0) return;
+
+    if (job->has_image) {
+        // gs_image_file4_free 會銷毀紋理，需在圖形上下文中執行（可重入）
+        obs_enter_graphics();
+        gs_image_file4_free(&job->image);
+        obs_leave_graphics();
+    }
+    for (uint32_t i = 0; i < job->level_count; ++i) bfree(job->levels[i]);
+    bfree(job->path);
+    bfree(job);
+}
+
+// 一般 8 位元圖片在這裡縮小到顯示尺寸並產生 mip 鏈，繪製時只取樣需要的像素；
+// 其他格式（動態 GIF、高位元深度）維持原本的上傳方式
+static void texture_job_prepare_image(struct texture_job *job)
+{
+    gs_image_file_t *image = &job->image.image3.image2.image;
+    if (image->is_animated_gif || !image->texture_data || (image->format != GS_RGBA && image->format != GS_BGRA)) {
+        job->baked_scale = 1.0f;
+        return;
+    }
+
+    uint32_t width = image->cx, height = image->cy;
+    if (job->scale < 1.0f) {
+        width = (uint32_t)((float)image->cx * job->scale + 0.5f);
+        height = (uint32_t)((float)image->cy * job->scale + 0.5f);
+        if (width < 1) width = 1;
+        if (height < 1) height = 1;
+    }
+    if (width == image->cx && height == image->cy) {
+        // 不需縮小：直接接手解碼結果，gs_image_file4_free 不會再釋放
+        job->levels[0] = image->texture_data;
+        image->texture_data = NULL;
+    } else {
+        job->levels[0] = image_scale_area(image->texture_data, image->cx, image->cy, width, height);
+        if (!job->levels[0]) return;
+        bfree(image->texture_data);
+        image->texture_data = NULL;
+    }
+    job->width = width;
+    job->height = height;
+    job->format = image->format;
+    job->baked_scale = (float)width / (float)image->cx;
+    job->level_count = image_build_mips(job->levels, width, height, IMAGE_SCALE_MAX_LEVELS);
+}
+
+static void texture_job_run(struct texture_job *job)
+{
+    bool ok = false;
+    if (job->type == TEXTURE_JOB_CIRCLE) {
+        uint32_t size = 0;
+        job->levels[0] = circle_raster_ring(job->radius, job->thickness, job->color, job->alpha, &size);
+        job->level_count = job->levels[0] ? 1 : 0;
+        job->width = size;
+        job->height = size;
+        job->format = GS_RGBA;
+        ok = job->levels[0] != NULL;
+    } else {
+        // 使用 gs_image_file4_t 解碼圖片（使用直接Alpha通道），紋理留到圖形執行緒建立
+        gs_image_file4_init(&job->image, job->path, GS_IMAGE_ALPHA_STRAIGHT);
+        job->has_image = true;
+        ok = job->image.image3.image2.image.loaded;
+        if (!ok) {
+            blog(LOG_WARNING, BLOG_PREFIX "無法載入圖片: %s", job->path);
+        } else {
+            texture_job_prepare_image(job);
+        }
+    }
+    // 取消的工作維持取消狀態，由最後一個參照清理
+    os_atomic_compare_swap_long(&job->state, TEXTURE_JOB_PENDING, ok ? TEXTURE_JOB_DONE : TEXTURE_JOB_FAILED);
+}
+
+static void *texture_worker_thread(void *param)
+{
+    UNUSED_PARAMETER(param);
+    os_set_thread_name("dr_cursor_tracker: texture worker");
+
+    for (;;) {
+        os_sem_wait(g_queue_sem);
+        if (os_atomic_load_bool(&g_stopping)) break;
+
+        pthread_mutex_lock(&g_queue_mutex);
+        struct texture_job *job = g_queue_head;
+        if (job) {
+            g_queue_head = job->next;
+            if (!g_queue_head) g_queue_tail = NULL;
+            job->next = NULL;
+        }
+        pthread_mutex_unlock(&g_queue_mutex);
+        if (!job) continue;
+
+        if (os_atomic_load_long(&job->state) == TEXTURE_JOB_PENDING) {
+            texture_job_run(job);
+        }
+        texture_job_release(job);
+    }
+    return NULL;
+}
+
+void texture_worker_init(void)
+{
+    if (g_cache_initialized) return;
+    if (pthread_mutex_init(&g_cache_mutex, NULL) != 0) return;
+    g_cache_initialized = true;
+    if (pthread_mutex_init(&g_queue_mutex, NULL) != 0) return;
+    if (os_sem_init(&g_queue_sem, 0) != 0) {
+        pthread_mutex_destroy(&g_queue_mutex);
+        return;
+    }
+    os_atomic_store_bool(&g_stopping, false);
+    g_thread_created = pthread_create(&g_thread, NULL, texture_worker_thread, NULL) == 0;
+    if (!g_thread_created) {
+        // 沒有工作執行緒時改在請求的執行緒上同步執行
+        blog(LOG_WARNING, BLOG_PREFIX "無法建立紋理工作執行緒，改為同步產生紋理");
+    }
+}
+
+void texture_worker_free(void)
+{
+    if (!g_cache_initialized) return;
+    if (g_thread_created) {
+        os_atomic_store_bool(&g_stopping, true);
+        os_sem_post(g_queue_sem);
+        pthread_join(g_thread, NULL);
+        g_thread_created = false;
+    }
+
+    // 釋放尚未執行的工作
+    struct texture_job *job = g_queue_head;
+    while (job) {
+        struct texture_job *next = job->next;
+        texture_job_release(job);
+        job = next;
+    }
+    g_queue_head = NULL;
+    g_queue_tail = NULL;
+    if (g_queue_sem) {
+        os_sem_destroy(g_queue_sem);
+        g_queue_sem = NULL;
+        pthread_mutex_destroy(&g_queue_mutex);
+    }
+
+    // 先在鎖內取下整個快取，持有快取鎖時不可進入圖形上下文
+    pthread_mutex_lock(&g_cache_mutex);
+    struct texture_entry *entries = g_entries;
+    g_entries = NULL;
+    g_cache_bytes = 0;
+    pthread_mutex_unlock(&g_cache_mutex);
+
+    obs_enter_graphics();
+    struct texture_entry *entry = entries;
+    while (entry) {
+        struct texture_entry *next = entry->next;
+        if (entry->refs > 0) blog(LOG_WARNING, BLOG_PREFIX "卸載時紋理快取仍有 %ld 個參照", entry->refs);
+        gs_texture_destroy(entry->texture);
+        texture_job_release(entry->job);
+        bfree(entry);
+        entry = next;
+    }
+    obs_leave_graphics();
+    pthread_mutex_destroy(&g_cache_mutex);
+    g_cache_initialized = false;
+}
+
+static void texture_worker_submit(struct texture_job *job)
+{
+    if (!g_thread_created) {
+        texture_job_run(job);
+        return;
+    }
+    os_atomic_inc_long(&job->refs); // 佇列持有的參照
+    pthread_mutex_lock(&g_queue_mutex);
+    if (g_queue_tail) {
+        g_queue_tail->next = job;
+    } else {
+        g_queue_head = job;
+    }
+    g_queue_tail = job;
+    pthread_mutex_unlock(&g_queue_mutex);
+    os_sem_post(g_queue_sem);
+}
+
+// ---------------------------------------------------------------------------
+// 快取（以下 *_locked 函式都需持有 g_cache_mutex）
+
+static struct texture_entry *texture_cache_find_locked(uint64_t key)
+{
+    for (struct texture_entry *e = g_entries; e; e = e->next) {
+        if (e->key == key) return e;
+    }
+    return NULL;
+}
+
+static void texture_cache_unlink_locked(struct texture_entry *entry)
+{
+    struct texture_entry **link = &g_entries;
+    while (*link && *link != entry) link = &(*link)->next;
+    if (*link) *link = entry->next;
+    g_cache_bytes -= entry->bytes;
+}
+
+// 釋放一個插槽參照；載入中的項目沒有人等待時直接取消，回傳需在鎖外釋放的工作
+static struct texture_job *texture_entry_release_locked(struct texture_entry *entry)
+{
+    if (!entry || --entry->refs > 0) return NULL;
+    if (entry->state == TEXTURE_ENTRY_READY) return NULL; // 保留在 LRU 中
+
+    struct texture_job *job = entry->job;
+    if (job) os_atomic_set_long(&job->state, TEXTURE_JOB_CANCELED);
+    texture_cache_unlink_locked(entry);
+    bfree(entry);
+    return job;
+}
+
+// 釋放沒有參照的舊版本圖片，再依 LRU 釋放紋理直到總量不超過上限（圖形執行緒）
+static void texture_cache_trim_locked(void)
+{
+    struct texture_entry **link = &g_entries;
+    while (*link) {
+        struct texture_entry *e = *link;
+        if (e->stale && e->refs == 0) {
+            *link = e->next;
+            g_cache_bytes -= e->bytes;
+            gs_texture_destroy(e->texture);
+            bfree(e);
+        } else {
+            link = &e->next;
+        }
+    }
+
+    while (g_cache_bytes > TEXTURE_CACHE_BUDGET) {
+        struct texture_entry *oldest = NULL;
+        for (struct texture_entry *e = g_entries; e; e = e->next) {
+            if (e->refs == 0 && (!oldest || e->last_used < oldest->last_used)) oldest = e;
+        }
+        if (!oldest) break; // 其餘都在使用中
+        texture_cache_unlink_locked(oldest);
+        gs_texture_destroy(oldest->texture);
+        bfree(oldest);
+    }
+}
+
+// 載入完成的項目在圖形執行緒上上傳，回傳需在鎖外釋放的工作
+static struct texture_job *texture_entry_upload_locked(struct texture_entry *entry)
+{
+    struct texture_job *job = entry->job;
+    long state = job ? os_atomic_load_long(&job->state) : TEXTURE_JOB_FAILED;
+    if (state == TEXTURE_JOB_PENDING) return NULL;
+
+    gs_texture_t *texture = NULL;
+    if (state == TEXTURE_JOB_DONE) {
+        if (job->level_count) {
+            texture = gs_texture_create(job->width, job->height, job->format, job->level_count,
+                                        (const uint8_t **)job->levels, 0);
+        } else {
+            gs_image_file4_init_texture(&job->image);
+            texture = job->image.image3.image2.image.texture;
+            job->image.image3.image2.image.texture = NULL; // 防止被 gs_image_file4_free 銷毀
+            if (!texture) blog(LOG_WARNING, BLOG_PREFIX "無法初始化紋理");
+        }
+    }
+
+    entry->job = NULL;
+    entry->texture = texture;
+    entry->state = texture ? TEXTURE_ENTRY_READY : TEXTURE_ENTRY_FAILED;
+    if (texture) {
+        uint32_t width = gs_texture_get_width(texture), height = gs_texture_get_height(texture);
+        uint32_t levels = job->level_count ? job->level_count : 1;
+        entry->baked_scale = job->baked_scale;
+        entry->bytes = 0;
+        for (uint32_t i = 0; i < levels; ++i) {
+            entry->bytes += (size_t)(width > 1 ? width : 1) * (height > 1 ? height : 1) * 4;
+            width /= 2;
+            height /= 2;
+        }
+        g_cache_bytes += entry->bytes;
+    }
+    return job;
+}
+
+void texture_slot_init(struct texture_slot *slot)
+{
+    memset(slot, 0, sizeof(*slot));
+}
+
+void texture_slot_free(struct texture_slot *slot)
+{
+    pthread_mutex_lock(&g_cache_mutex);
+    struct texture_job *pending = texture_entry_release_locked(slot->pending);
+    struct texture_job *current = texture_entry_release_locked(slot->current);
+    slot->pending = NULL;
+    slot->current = NULL;
+    texture_cache_trim_locked();
+    pthread_mutex_unlock(&g_cache_mutex);
+
+    texture_job_release(pending);
+    texture_job_release(current);
+}
+
+// FNV-1a，用來比對產生參數
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// 取得鍵對應的項目；不存在時以 job 建立並排程，否則丟棄 job
+// path_key 不為 0 時，同一路徑其他版本的項目標記為過期
+static void texture_slot_request(struct texture_slot *slot, uint64_t key, uint64_t path_key, uint64_t version,
+                                 struct texture_job *(*make_job)(void *), void *param)
+{
+    pthread_mutex_lock(&g_cache_mutex);
+    struct texture_entry *target = slot->pending ? slot->pending : slot->current;
+    if (target && target->key == key) {
+        pthread_mutex_unlock(&g_cache_mutex);
+        return;
+    }
+
+    if (path_key) {
+        for (struct texture_entry *e = g_entries; e; e = e->next) {
+            if (e->path_key == path_key && e->version != version) e->stale = true;
+        }
+    }
+
+    struct texture_job *submit = NULL;
+    struct texture_entry *entry = texture_cache_find_locked(key);
+    if (entry) {
+        g_cache_hits++;
+        entry->stale = false;
+    } else {
+        g_cache_misses++;
+        entry = bzalloc(sizeof(struct texture_entry));
+        entry->key = key;
+        entry->path_key = path_key;
+        entry->version = version;
+        entry->job = make_job(param);
+        entry->next = g_entries;
+        g_entries = entry;
+        submit = entry->job;
+    }
+    entry->refs++;
+    entry->last_used = os_gettime_ns();
+
+    // 目前正在繪製的就是這個鍵時，直接取消等待中的請求
+    struct texture_job *canceled = NULL;
+    if (entry == slot->current) {
+        canceled = texture_entry_release_locked(slot->pending);
+        slot->pending = NULL;
+        entry->refs--;
+    } else {
+        canceled = texture_entry_release_locked(slot->pending);
+        slot->pending = entry;
+    }
+    // 工作提交前先持有佇列的參照，避免在鎖外被取消後釋放
+    if (submit) os_atomic_inc_long(&submit->refs);
+    pthread_mutex_unlock(&g_cache_mutex);
+
+    texture_job_release(canceled);
+    if (submit) {
+        texture_worker_submit(submit);
+        texture_job_release(submit);
+    }
+}
+
+struct circle_params {
+    int radius;
+    int thickness;
+    uint32_t color;
+    float alpha;
+};
+
+static struct texture_job *make_circle_job(void *param)
+{
+    const struct circle_params *p = param;
+    struct texture_job *job = bzalloc(sizeof(struct texture_job));
+    job->refs = 1; // 快取項目持有的參照
+    job->type = TEXTURE_JOB_CIRCLE;
+    job->radius = p->radius;
+    job->thickness = p->thickness;
+    job->color = p->color;
+    job->alpha = p->alpha;
+    job->baked_scale = 1.0f;
+    return job;
+}
+
+struct image_params {
+    const char *path;
+    float scale;
+};
+
+static struct texture_job *make_image_job(void *param)
+{
+    const struct image_params *p = param;
+    struct texture_job *job = bzalloc(sizeof(struct texture_job));
+    job->refs = 1;
+    job->type = TEXTURE_JOB_IMAGE;
+    job->path = bstrdup(p->path);
+    job->scale = p->scale;
+    job->baked_scale = 1.0f;
+    return job;
+}
+
+void texture_slot_request_circle(struct texture_slot *slot, int radius, int thickness, uint32_t color, float alpha)
+{
+    struct circle_params p = {radius, thickness, color, alpha};
+    uint64_t key = 14695981039346656037ULL;
+    int type = TEXTURE_JOB_CIRCLE;
+    key = hash_bytes(key, &type, sizeof(type));
+    key = hash_bytes(key, &p.radius, sizeof(p.radius));
+    key = hash_bytes(key, &p.thickness, sizeof(p.thickness));
+    key = hash_bytes(key, &p.color, sizeof(p.color));
+    key = hash_bytes(key, &p.alpha, sizeof(p.alpha));
+    texture_slot_request(slot, key, 0, 0, make_circle_job, &p);
+}
+
+// 檔案的修改時間（Linux 為奈秒，Windows 為 100 奈秒單位）與大小；無法取得時都是 0
+static void image_file_version(const char *path, int64_t *mtime, int64_t *size)
+{
+    *mtime = 0;
+    *size = 0;
+#ifdef _WIN32
+    wchar_t *wpath = NULL;
+    if (!os_utf8_to_wcs_ptr(path, 0, &wpath)) return;
+    WIN32_FILE_ATTRIBUTE_DATA attr;
+    if (GetFileAttributesExW(wpath, GetFileExInfoStandard, &attr)) {
+        *mtime = (int64_t)(((uint64_t)attr.ftLastWriteTime.dwHighDateTime << 32) |
+                           attr.ftLastWriteTime.dwLowDateTime);
+        *size = (int64_t)(((uint64_t)attr.nFileSizeHigh << 32) | attr.nFileSizeLow);
+    }
+    bfree(wpath);
+#else
+    struct stat st;
+    if (os_stat(path, &st) == 0) {
+        *mtime = (int64_t)st.st_mtim.tv_sec * 1000000000LL + (int64_t)st.st_mtim.tv_nsec;
+        *size = (int64_t)st.st_size;
+    }
+#endif
+}
+
+void texture_slot_request_image(struct texture_slot *slot, const char *path, float scale)
+{
+    if (!path || !*path) return;
+
+    // 修改時間與大小也是鍵的一部分，檔案被覆寫後會重新解碼，舊版本的紋理在不再使用後釋放
+    int64_t mtime, size;
+    image_file_version(path, &mtime, &size);
+    uint64_t path_key = 14695981039346656037ULL;
+    int type = TEXTURE_JOB_IMAGE;
+    path_key = hash_bytes(path_key, &type, sizeof(type));
+    path_key = hash_bytes(path_key, path, strlen(path));
+    uint64_t version = 14695981039346656037ULL;
+    version = hash_bytes(version, &mtime, sizeof(mtime));
+    version = hash_bytes(version, &size, sizeof(size));
+
+    uint64_t key = hash_bytes(path_key, &version, sizeof(version));
+    // 放大由 GPU 取樣處理，所有不小於 1 的比例共用原尺寸的紋理
+    struct image_params p = {path, scale < 1.0f ? scale : 1.0f};
+    key = hash_bytes(key, &p.scale, sizeof(p.scale));
+    texture_slot_request(slot, key, path_key, version, make_image_job, &p);
+}
+
+gs_texture_t *texture_slot_get(struct texture_slot *slot)
+{
+    struct texture_job *done = NULL;
+    struct texture_job *released = NULL;
+
+    pthread_mutex_lock(&g_cache_mutex);
+    struct texture_entry *pending = slot->pending;
+    if (pending && pending->state == TEXTURE_ENTRY_LOADING) {
+        // 共用同一個項目的實例中，第一個看到工作完成的負責上傳
+        done = texture_entry_upload_locked(pending);
+    }
+    if (pending && pending->state != TEXTURE_ENTRY_LOADING) {
+        // 失敗時不保留舊參數的紋理，與同步載入失敗時的行為一致
+        released = texture_entry_release_locked(slot->current);
+        slot->current = pending;
+        slot->pending = NULL;
+        texture_cache_trim_locked();
+    }
+
+    gs_texture_t *texture = NULL;
+    if (slot->current) {
+        slot->current->last_used = os_gettime_ns();
+        texture = slot->current->texture;
+    }
+    pthread_mutex_unlock(&g_cache_mutex);
+
+    texture_job_release(done);
+    texture_job_release(released);
+    return texture;
+}
+
+float texture_slot_baked_scale(struct texture_slot *slot)
+{
+    pthread_mutex_lock(&g_cache_mutex);
+    float scale = slot->current && slot->current->texture ? slot->current->baked_scale : 1.0f;
+    pthread_mutex_unlock(&g_cache_mutex);
+    return scale;
+}
+
+bool texture_slot_loading(struct texture_slot *slot)
+{
+    pthread_mutex_lock(&g_cache_mutex);
+    bool loading = slot->pending && slot->pending->state == TEXTURE_ENTRY_LOADING;
+    pthread_mutex_unlock(&g_cache_mutex);
+    return loading;
+}
+
+void texture_cache_get_stats(struct texture_cache_stats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (!g_cache_initialized) return;
+    pthread_mutex_lock(&g_cache_mutex);
+    for (struct texture_entry *e = g_entries; e; e = e->next) {
+        stats->entries++;
+        if (e->refs == 0) stats->unreferenced++;
+    }
+    stats->bytes = g_cache_bytes;
+    stats->hits = g_cache_hits;
+    stats->misses = g_cache_misses;
+    pthread_mutex_unlock(&g_cache_mutex);
+}
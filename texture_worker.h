@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <obs-module.h>
+
+// 背景紋理工作佇列與全模組共用的紋理快取
+// 圓環點陣化與圖片解碼（含縮小與 mip 鏈）在共用的工作執行緒上完成，只產生 CPU 像素資料；
+// 繪製時由 texture_slot_get 在圖形執行緒上做一次短暫的上傳，再替換掉舊紋理。
+// 新紋理完成前，插槽會繼續回傳舊紋理，設定變更不會讓畫面停頓或閃爍。
+//
+// 紋理以產生參數（圓環的半徑、粗細、顏色、透明度；圖片的路徑、修改時間、大小與縮放）為鍵放在快取中，
+// 參數相同的實例共用同一份上傳（含進行中的工作）。沒有插槽參照的紋理保留在 LRU 中，
+// 重新建立相同設定的來源時直接取用；總量超過 TEXTURE_CACHE_BUDGET 時從最久未使用的開始釋放。
+
+#define TEXTURE_CACHE_BUDGET (256ULL * 1024 * 1024) // 快取紋理的顯示記憶體上限（位元組）
+
+struct texture_entry;
+
+// 每個來源實例持有的紋理插槽（由全模組的快取鎖保護）
+struct texture_slot {
+    struct texture_entry *pending; // 已請求但尚未可用的紋理
+    struct texture_entry *current; // 目前繪製中的紋理
+};
+
+struct texture_cache_stats {
+    size_t bytes;       // 快取中所有紋理的大小
+    size_t entries;
+    size_t unreferenced; // 沒有插槽參照、可被釋放的項目
+    uint64_t hits;      // 請求時已在快取中（含進行中）
+    uint64_t misses;
+};
+
+// 啟動 / 停止工作執行緒（obs_module_load / obs_module_unload）
+void texture_worker_init(void);
+void texture_worker_free(void);
+
+void texture_slot_init(struct texture_slot *slot);
+// 釋放插槽的參照；需在圖形上下文中呼叫
+void texture_slot_free(struct texture_slot *slot);
+
+// 請求新的紋理；與目前請求的參數相同時不做任何事
+void texture_slot_request_circle(struct texture_slot *slot, int radius, int thickness, uint32_t color, float alpha);
+// scale 小於 1 時在背景以面積平均縮小到顯示尺寸；一般圖片都會產生 mip 鏈
+void texture_slot_request_image(struct texture_slot *slot, const char *path, float scale);
+
+// 上傳已完成的工作並回傳目前的紋理；需在圖形執行緒上呼叫
+gs_texture_t *texture_slot_get(struct texture_slot *slot);
+// 目前紋理已預先縮放的比例（1 = 原尺寸），繪製時以 顯示比例 / 此值 縮放
+float texture_slot_baked_scale(struct texture_slot *slot);
+// 是否有尚未完成的請求（可用來在第一次載入時顯示佔位圖形）
+bool texture_slot_loading(struct texture_slot *slot);
+
+void texture_cache_get_stats(struct texture_cache_stats *stats);
@@ -0,0 +1,161 @@
+// circle_bench：比較圓環點陣化的逐像素實作與象限鏡射 + SIMD 實作
+//
+// 對每個半徑以各指令集產生紋理，確認與逐像素版本逐位元相同，並輸出平均耗時與加速比。
+// 用法：circle_bench [--thickness N] [--iterations N] [半徑 ...]（預設半徑 8 ~ 2000）
+
+#include "../circle_raster.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 插件原本在 create_circle_texture 中使用的逐像素實作，作為正確性與效能的基準
+static inline float clampf(float x, float min_val, float max_val)
+{
+    if (x < min_val) return min_val;
+    if (x > max_val) return max_val;
+    return x;
+}
+
+static inline float smoothstep(float edge0, float edge1, float x)
+{
+    float t = clampf((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static uint8_t *naive_ring(int radius, int thickness, uint32_t color, float alpha, uint32_t *size)
+{
+    int texture_size = (radius + thickness) * 2;
+    *size = (uint32_t)texture_size;
+    uint8_t *data = calloc((size_t)texture_size * texture_size, 4);
+
+    float center = (float)texture_size / 2.0f;
+    float inner_radius = (float)radius;
+    float outer_radius = (float)(radius + thickness);
+    float edge_distance = 1.0f;
+
+    uint8_t r = (color >> 16) & 0xFF;
+    uint8_t g = (color >> 8) & 0xFF;
+    uint8_t b = color & 0xFF;
+    uint8_t a = (uint8_t)(alpha * 255);
+
+    for (int y = 0; y < texture_size; y++) {
+        for (int x = 0; x < texture_size; x++) {
+            float dx = (float)x - center;
+            float dy = (float)y - center;
+            float distance = sqrtf(dx * dx + dy * dy);
+
+            if (distance >= inner_radius - edge_distance && distance <= outer_radius + edge_distance) {
+                float fade_in = smoothstep(inner_radius, inner_radius + edge_distance, distance);
+                float fade_out = smoothstep(outer_radius - edge_distance, outer_radius, distance);
+                float alpha_multiplier = fade_in * (1.0f - fade_out);
+
+                size_t index = ((size_t)y * texture_size + x) * 4;
+                data[index + 0] = r;
+                data[index + 1] = g;
+                data[index + 2] = b;
+                data[index + 3] = (uint8_t)(a * alpha_multiplier);
+            }
+        }
+    }
+    return data;
+}
+
+// 外掛以 libobs 的 bmem 配置記憶體；工具不連結 libobs，直接對應到 C 標準函式庫
+void *bmalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static const char *isa_name(enum circle_raster_isa isa)
+{
+    switch (isa) {
+    case CIRCLE_RASTER_ISA_SCALAR: return "scalar";
+    case CIRCLE_RASTER_ISA_SSE2: return "sse2";
+    case CIRCLE_RASTER_ISA_AVX2: return "avx2";
+    default: return "auto";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const int default_radii[] = {8, 16, 32, 64, 128, 256, 512, 1000, 2000};
+    int radii[64];
+    int radius_count = 0;
+    int thickness = 4;
+    int iterations = 0; // 0 = 依大小自動決定
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--thickness") && i + 1 < argc) {
+            thickness = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (argv[i][0] != '-' && radius_count < 64) {
+            radii[radius_count++] = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "usage: %s [--thickness N] [--iterations N] [radius ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (radius_count == 0) {
+        radius_count = (int)(sizeof(default_radii) / sizeof(default_radii[0]));
+        memcpy(radii, default_radii, sizeof(default_radii));
+    }
+
+    const enum circle_raster_isa isas[] = {CIRCLE_RASTER_ISA_SCALAR, CIRCLE_RASTER_ISA_SSE2, CIRCLE_RASTER_ISA_AVX2};
+    const uint32_t color = 0xFF3080F0;
+    const float alpha = 0.8f;
+    bool mismatch = false;
+
+    printf("radius,thickness,size,impl,ms,speedup,identical\n");
+    for (int r = 0; r < radius_count; ++r) {
+        int radius = radii[r];
+        uint32_t size = 0;
+        size_t bytes = (size_t)(radius + thickness) * 2 * (size_t)(radius + thickness) * 2 * 4;
+        int n = iterations > 0 ? iterations : (int)(200000000 / (bytes + 1)) + 1;
+        if (n > 200) n = 200;
+
+        double t0 = now_seconds();
+        uint8_t *reference = NULL;
+        for (int k = 0; k < n; ++k) {
+            free(reference);
+            reference = naive_ring(radius, thickness, color, alpha, &size);
+        }
+        double naive_ms = (now_seconds() - t0) * 1000.0 / n;
+        printf("%d,%d,%u,naive,%.3f,1.00,yes\n", radius, thickness, size, naive_ms);
+
+        for (size_t k = 0; k < sizeof(isas) / sizeof(isas[0]); ++k) {
+            enum circle_raster_isa isa = circle_raster_resolve_isa(isas[k]);
+            if (isa != isas[k]) continue; // CPU 不支援
+
+            uint8_t *pixels = NULL;
+            t0 = now_seconds();
+            for (int j = 0; j < n; ++j) {
+                bfree(pixels);
+                pixels = circle_raster_ring_isa(radius, thickness, color, alpha, &size, isa);
+            }
+            double ms = (now_seconds() - t0) * 1000.0 / n;
+            bool identical = memcmp(pixels, reference, bytes) == 0;
+            mismatch = mismatch || !identical;
+            printf("%d,%d,%u,%s,%.3f,%.2f,%s\n", radius, thickness, size, isa_name(isa), ms, naive_ms / ms,
+                   identical ? "yes" : "NO");
+            bfree(pixels);
+        }
+        free(reference);
+    }
+    return mismatch ? 2 : 0;
+}
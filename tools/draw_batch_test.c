@@ -0,0 +1,272 @@
+// draw_batch_test：確認批次繪製每幀只發出一次繪製呼叫
+//
+// 以計數用的 gs_* 替身連結插件的 draw_batch.c，依插件 render 的順序（begin → 寫入圖元 → upload → draw）
+// 每幀寫入 N 個混合的圖元（方框、線段、SDF 形狀與緞帶三角形帶），確認：
+//   - 每幀剛好一次 gs_draw，且繪製的頂點數等於寫入的頂點數
+//   - 插入自訂圖片的分界時剛好兩次，兩段的頂點數相加等於總數
+//   - 容量穩定後不再重建頂點緩衝區，每幀只上傳一次且只上傳寫入的頂點
+// 用法：draw_batch_test [--frames N] [圖元數 ...]（預設 1、10、100、1000、10000）
+
+#include "../draw_batch.h"
+#include <graphics/graphics.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct gs_vertex_buffer {
+    struct gs_vb_data *data;
+};
+
+struct gs_effect_technique {
+    int passes;
+};
+
+// 替身記錄的呼叫次數與最後一次繪製的範圍
+static struct {
+    int draws;
+    int buffers_created;
+    int flushes;
+    size_t uploaded_vertices;
+    int techniques_open;
+    uint32_t last_start;
+    uint32_t last_count;
+    uint32_t drawn_vertices;
+} calls;
+
+// 工具不連結 libobs：bmem 對應到 C 標準函式庫，記錄只輸出到 stderr
+void *bmalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void *brealloc(void *ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+void blog(int log_level, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[%d] ", log_level);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+gs_vertbuffer_t *gs_vertexbuffer_create(struct gs_vb_data *data, uint32_t flags)
+{
+    (void)flags;
+    gs_vertbuffer_t *vbuffer = malloc(sizeof(gs_vertbuffer_t));
+    vbuffer->data = data;
+    calls.buffers_created++;
+    return vbuffer;
+}
+
+void gs_vertexbuffer_destroy(gs_vertbuffer_t *vbuffer)
+{
+    if (!vbuffer) return;
+    gs_vbdata_destroy(vbuffer->data);
+    free(vbuffer);
+}
+
+struct gs_vb_data *gs_vertexbuffer_get_data(const gs_vertbuffer_t *vbuffer)
+{
+    return vbuffer->data;
+}
+
+void gs_vertexbuffer_flush_direct(gs_vertbuffer_t *vbuffer, const struct gs_vb_data *data)
+{
+    if (data->points != vbuffer->data->points || data->colors != vbuffer->data->colors ||
+        data->num > vbuffer->data->num) {
+        fprintf(stderr, "上傳的資料不屬於這個頂點緩衝區或超出容量\n");
+        exit(3);
+    }
+    calls.flushes++;
+    calls.uploaded_vertices = data->num;
+}
+
+void gs_draw(enum gs_draw_mode draw_mode, uint32_t start_vert, uint32_t num_verts)
+{
+    if (draw_mode != GS_TRIS || calls.techniques_open != 1) {
+        fprintf(stderr, "gs_draw 在 technique 之外或不是三角形清單\n");
+        exit(3);
+    }
+    calls.draws++;
+    calls.last_start = start_vert;
+    calls.last_count = num_verts;
+    calls.drawn_vertices += num_verts;
+}
+
+size_t gs_technique_begin(gs_technique_t *technique)
+{
+    calls.techniques_open++;
+    return (size_t)technique->passes;
+}
+
+bool gs_technique_begin_pass(gs_technique_t *technique, size_t pass)
+{
+    return pass < (size_t)technique->passes;
+}
+
+void gs_technique_end_pass(gs_technique_t *technique)
+{
+    (void)technique;
+}
+
+void gs_technique_end(gs_technique_t *technique)
+{
+    (void)technique;
+    calls.techniques_open--;
+}
+
+void gs_blend_state_push(void) {}
+void gs_blend_state_pop(void) {}
+void gs_blend_function_separate(enum gs_blend_type src_c, enum gs_blend_type dest_c, enum gs_blend_type src_a,
+                                enum gs_blend_type dest_a)
+{
+    (void)src_c;
+    (void)dest_c;
+    (void)src_a;
+    (void)dest_a;
+}
+void gs_enable_color(bool red, bool green, bool blue, bool alpha)
+{
+    (void)red;
+    (void)green;
+    (void)blue;
+    (void)alpha;
+}
+void gs_load_vertexbuffer(gs_vertbuffer_t *vbuffer)
+{
+    (void)vbuffer;
+}
+void gs_load_indexbuffer(gs_indexbuffer_t *ibuffer)
+{
+    (void)ibuffer;
+}
+
+#define RIBBON_POINTS 16
+
+// 依序寫入 count 個圖元，回傳寫入的頂點數
+static size_t emit_primitives(struct draw_batch *batch, int count, int frame)
+{
+    size_t vertices = 0;
+    for (int i = 0; i < count; ++i) {
+        float x = (float)((i * 37 + frame * 11) % 1920);
+        float y = (float)((i * 53 + frame * 7) % 1080);
+        switch (i % 4) {
+        case 0:
+            draw_batch_rect(batch, x, y, 40.0f, 2.0f, 0xFF00FF00);
+            vertices += 6;
+            break;
+        case 1:
+            draw_batch_line(batch, x, y, x + 30.0f, y + 12.0f, 3.0f, 0xFFFFFFFF);
+            vertices += 6;
+            break;
+        case 2:
+            draw_batch_shape(batch, (enum draw_shape)(1 + i % 3), x, y, 10.0f, 10.0f, 4.0f, 8.0f, 0x80FF0000);
+            vertices += 6;
+            break;
+        default: {
+            struct vec3 *points;
+            uint32_t *colors;
+            if (!draw_batch_strip_reserve(batch, RIBBON_POINTS, &points, &colors)) break;
+            for (int k = 0; k < RIBBON_POINTS; ++k) {
+                vec3_set(&points[k], x + (float)(k / 2) * 4.0f, y + (float)(k % 2) * 6.0f, 0.0f);
+                colors[k] = 0xC0FFFF00;
+            }
+            draw_batch_strip_commit(batch, RIBBON_POINTS);
+            vertices += (RIBBON_POINTS - 2) * 3;
+            break;
+        }
+        }
+    }
+    return vertices;
+}
+
+static bool check(bool condition, int primitives, int frame, const char *what)
+{
+    if (!condition) fprintf(stderr, "N=%d，第 %d 幀：%s\n", primitives, frame, what);
+    return condition;
+}
+
+// 模擬 count 個圖元的 frames 幀；split 時在中間插入自訂圖片的分界，與插件的兩段繪製相同
+static bool run(int primitives, int frames, bool split)
+{
+    struct gs_effect_technique tech = {1};
+    struct draw_batch batch;
+    draw_batch_init(&batch);
+    bool ok = true;
+    int buffers_after_first = 0;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        memset(&calls, 0, sizeof(calls));
+        draw_batch_begin(&batch);
+        size_t vertices = emit_primitives(&batch, primitives / 2, frame);
+        size_t image_layer = draw_batch_mark(&batch);
+        vertices += emit_primitives(&batch, primitives - primitives / 2, frame);
+
+        int draws = 0;
+        if (draw_batch_upload(&batch)) {
+            if (split) {
+                draws += draw_batch_draw(&batch, &tech, 0, image_layer);
+                draws += draw_batch_draw(&batch, &tech, image_layer, batch.count);
+            } else {
+                draws += draw_batch_draw(&batch, &tech, 0, batch.count);
+            }
+        }
+
+        int expected = split ? (image_layer > 0) + (batch.count > image_layer) : 1;
+        ok &= check(batch.count == vertices, primitives, frame, "寫入的頂點數與圖元不符");
+        ok &= check(draws == expected && calls.draws == expected, primitives, frame, "繪製呼叫次數錯誤");
+        ok &= check(calls.drawn_vertices == vertices, primitives, frame, "繪製的頂點數與寫入的不同");
+        ok &= check(calls.flushes == 1, primitives, frame, "每幀應只上傳一次");
+        ok &= check(calls.uploaded_vertices == vertices, primitives, frame, "上傳的頂點數與寫入的不同");
+        if (frame > 0) buffers_after_first += calls.buffers_created;
+    }
+    ok &= check(buffers_after_first == 0, primitives, frames, "容量穩定後仍重建頂點緩衝區");
+
+    draw_batch_free(&batch);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const int default_counts[] = {1, 10, 100, 1000, 10000};
+    int counts[64];
+    int count_n = 0;
+    int frames = 8;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (argv[i][0] != '-' && count_n < 64) {
+            counts[count_n++] = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [primitives ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (count_n == 0) {
+        count_n = (int)(sizeof(default_counts) / sizeof(default_counts[0]));
+        memcpy(counts, default_counts, sizeof(default_counts));
+    }
+
+    bool ok = true;
+    printf("primitives,frames,layout,result\n");
+    for (int i = 0; i < count_n; ++i) {
+        bool single = run(counts[i], frames, false);
+        bool split = run(counts[i], frames, true);
+        printf("%d,%d,single,%s\n", counts[i], frames, single ? "ok" : "FAIL");
+        printf("%d,%d,split,%s\n", counts[i], frames, split ? "ok" : "FAIL");
+        ok = ok && single && split;
+    }
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,188 @@
+// monitor_bench：比較座標模式的螢幕查詢有無快取的耗時
+//
+// 以假的滑鼠來源後端提供 1 ~ 8 個螢幕的配置（每列四個、寬高交錯），模擬兩種查詢方式：
+//   uncached：插件原本的做法，每次查詢都向後端列舉所有螢幕再逐一比對
+//   cached：monitor_cache_refresh（世代未變時不列舉）+ monitor_cache_find
+// 滑鼠軌跡分為 stay（大多停在同一個螢幕，偶爾跳到其他螢幕）與 hop（每次查詢換一個螢幕，
+// 上次命中的螢幕全部失效）。兩種方式的結果必須相同，否則回傳失敗。
+// 假後端的列舉只複製陣列；實際的 EnumDisplayMonitors / XRRGetMonitors 還有系統呼叫或 X 伺服器往返，
+// 所以 uncached 的實際成本比這裡量到的更高。
+// 用法：monitor_bench [--lookups N]
+
+#include "../monitor_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct fake_display {
+    struct cursor_rect rects[MONITOR_CACHE_MAX];
+    int count;
+    long generation;
+    long enumerations;
+};
+
+static void *fake_create(void)
+{
+    return NULL;
+}
+
+static void fake_destroy(void *data)
+{
+    (void)data;
+}
+
+static bool fake_get_position(void *data, int32_t *x, int32_t *y)
+{
+    (void)data;
+    *x = *y = 0;
+    return true;
+}
+
+static int fake_enum_monitors(void *data, struct cursor_rect *rects, int max_count)
+{
+    struct fake_display *display = data;
+    int count = display->count < max_count ? display->count : max_count;
+    memcpy(rects, display->rects, sizeof(struct cursor_rect) * count);
+    display->enumerations++;
+    return count;
+}
+
+static long fake_monitor_generation(void *data)
+{
+    return ((struct fake_display *)data)->generation;
+}
+
+static const struct cursor_provider_ops fake_ops = {
+    .name = "fake",
+    .create = fake_create,
+    .destroy = fake_destroy,
+    .get_position = fake_get_position,
+    .enum_monitors = fake_enum_monitors,
+    .monitor_generation = fake_monitor_generation,
+};
+
+// 每列四個螢幕，1920x1080 與 2560x1440 交錯
+static void fake_layout(struct fake_display *display, int count)
+{
+    memset(display, 0, sizeof(*display));
+    int32_t x = 0;
+    for (int i = 0; i < count; ++i) {
+        if (i % 4 == 0) x = 0;
+        int32_t width = (i % 2) ? 2560 : 1920;
+        int32_t height = (i % 2) ? 1440 : 1080;
+        int32_t top = (i / 4) * 1440;
+        display->rects[i] = (struct cursor_rect){x, top, x + width, top + height};
+        x += width;
+    }
+    display->count = count;
+    display->generation = 1;
+}
+
+// 插件原本的查詢：每次列舉所有螢幕，找到包含滑鼠的螢幕就停止
+static bool uncached_find(struct cursor_provider *provider, int32_t x, int32_t y, struct cursor_rect *rect)
+{
+    struct cursor_rect rects[MONITOR_CACHE_MAX];
+    int count = cursor_provider_enum_monitors(provider, rects, MONITOR_CACHE_MAX);
+    for (int i = 0; i < count; ++i) {
+        if (x >= rects[i].left && x < rects[i].right && y >= rects[i].top && y < rects[i].bottom) {
+            *rect = rects[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+struct point {
+    int32_t x;
+    int32_t y;
+};
+
+// stay：每 500 次查詢換一次螢幕，其餘時間在同一個螢幕內移動；hop：每次查詢都隨機選一個螢幕
+static void make_path(const struct fake_display *display, struct point *points, int lookups, bool hop)
+{
+    uint32_t seed = 12345;
+    int monitor = 0;
+    for (int i = 0; i < lookups; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        if (hop || i % 500 == 0) monitor = (int)((seed >> 8) % (uint32_t)display->count);
+        const struct cursor_rect *r = &display->rects[monitor];
+        seed = seed * 1664525u + 1013904223u;
+        points[i].x = r->left + (int32_t)((seed >> 8) % (uint32_t)(r->right - r->left));
+        seed = seed * 1664525u + 1013904223u;
+        points[i].y = r->top + (int32_t)((seed >> 8) % (uint32_t)(r->bottom - r->top));
+    }
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool same_rect(const struct cursor_rect *a, const struct cursor_rect *b)
+{
+    return a->left == b->left && a->top == b->top && a->right == b->right && a->bottom == b->bottom;
+}
+
+int main(int argc, char **argv)
+{
+    int lookups = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--lookups") && i + 1 < argc) {
+            lookups = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--lookups N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (lookups < 1) lookups = 1;
+
+    struct point *points = malloc(sizeof(struct point) * (size_t)lookups);
+    struct cursor_rect *expected = malloc(sizeof(struct cursor_rect) * (size_t)lookups);
+    if (!points || !expected) return 1;
+
+    bool mismatch = false;
+    printf("monitors,path,impl,ns_per_lookup,enumerations,speedup,identical\n");
+    for (int count = 1; count <= 8; ++count) {
+        struct fake_display display;
+        fake_layout(&display, count);
+        struct cursor_provider provider = {&fake_ops, &display};
+
+        for (int hop = 0; hop <= 1; ++hop) {
+            const char *path = hop ? "hop" : "stay";
+            make_path(&display, points, lookups, hop);
+
+            display.enumerations = 0;
+            double t0 = now_seconds();
+            for (int i = 0; i < lookups; ++i) {
+                if (!uncached_find(&provider, points[i].x, points[i].y, &expected[i])) {
+                    memset(&expected[i], 0, sizeof(expected[i]));
+                }
+            }
+            double uncached_ns = (now_seconds() - t0) * 1e9 / lookups;
+            printf("%d,%s,uncached,%.2f,%ld,1.00,yes\n", count, path, uncached_ns, display.enumerations);
+
+            struct monitor_cache cache;
+            monitor_cache_init(&cache);
+            display.enumerations = 0;
+            bool identical = true;
+            t0 = now_seconds();
+            for (int i = 0; i < lookups; ++i) {
+                struct cursor_rect rect = {0};
+                monitor_cache_refresh(&cache, &provider);
+                monitor_cache_find(&cache, points[i].x, points[i].y, &rect);
+                identical = identical && same_rect(&rect, &expected[i]);
+            }
+            double cached_ns = (now_seconds() - t0) * 1e9 / lookups;
+            mismatch = mismatch || !identical;
+            printf("%d,%s,cached,%.2f,%ld,%.2f,%s\n", count, path, cached_ns, display.enumerations,
+                   cached_ns > 0.0 ? uncached_ns / cached_ns : 0.0, identical ? "yes" : "NO");
+        }
+    }
+
+    free(points);
+    free(expected);
+    return mismatch ? 2 : 0;
+}
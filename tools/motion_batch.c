@@ -0,0 +1,416 @@
+#include "motion_batch.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MOTION_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MB_SSE2_TARGET
+#define MB_AVX2_TARGET
+#else
+#define MB_SSE2_TARGET __attribute__((target("sse2")))
+#define MB_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#define MOTION_BATCH_ALIGN 8 // 補齊到最寬的向量（AVX2 = 8 個 float）
+
+// ---------------------------------------------------------------------------
+// 純量路徑：直接使用插件的 motion_step / motion_apply_input
+
+static void motion_batch_state(const struct motion_batch *b, size_t lane, struct motion_state *state)
+{
+    motion_init(state, b->offset_x[lane], b->offset_y[lane]);
+    state->idle_time = b->idle_time[lane];
+}
+
+static void motion_batch_steps_scalar(struct motion_batch *b, uint64_t n, double first_time)
+{
+    const double step_seconds = (double)MOTION_STEP_NS / 1000000000.0;
+    for (size_t i = 0; i < b->count; ++i) {
+        struct motion_params params;
+        struct motion_state state;
+        motion_batch_params(b, i, &params);
+        motion_batch_state(b, i, &state);
+        float thr2 = b->settle_threshold[i] * b->settle_threshold[i];
+
+        for (uint64_t s = 0; s < n; ++s) {
+            motion_step(&state, &params);
+
+            float since = (float)(first_time + (double)s * step_seconds - b->last_input_time);
+            float ox = state.offset_x, oy = state.offset_y;
+            if (b->pending[i] > 0.0f && ox * ox + oy * oy <= thr2) {
+                if (since > b->settle_time[i]) b->settle_time[i] = since;
+                b->pending[i] = 0.0f;
+            }
+            if (ox * b->dir_x[i] < 0.0f && fabsf(ox) > b->overshoot[i]) b->overshoot[i] = fabsf(ox);
+            if (oy * b->dir_y[i] < 0.0f && fabsf(oy) > b->overshoot[i]) b->overshoot[i] = fabsf(oy);
+        }
+
+        b->offset_x[i] = state.offset_x;
+        b->offset_y[i] = state.offset_y;
+        b->idle_time[i] = state.idle_time;
+    }
+}
+
+static void motion_batch_input_scalar(struct motion_batch *b, float dx, float dy)
+{
+    for (size_t i = 0; i < b->count; ++i) {
+        struct motion_params params;
+        struct motion_state state;
+        motion_batch_params(b, i, &params);
+        motion_batch_state(b, i, &state);
+        motion_apply_input(&state, &params, dx, dy);
+
+        float ox = state.offset_x, oy = state.offset_y;
+        b->offset_x[i] = ox;
+        b->offset_y[i] = oy;
+        b->idle_time[i] = state.idle_time;
+        b->dir_x[i] = ox;
+        b->dir_y[i] = oy;
+        // 只有離開中心範圍的輸入才需要計算回中時間
+        if (ox * ox + oy * oy > b->settle_threshold[i] * b->settle_threshold[i]) b->pending[i] = 1.0f;
+        float peak = sqrtf(ox * ox + oy * oy);
+        if (peak > b->peak_offset[i]) b->peak_offset[i] = peak;
+    }
+}
+
+#ifdef MOTION_BATCH_X86
+// ---------------------------------------------------------------------------
+// SSE2
+
+static MB_SSE2_TARGET inline __m128 mb_select_sse2(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+static MB_SSE2_TARGET inline __m128 mb_curve_sse2(const float *lut, __m128 t)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 clamped = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), one);
+    __m128 pos = _mm_mul_ps(clamped, _mm_set1_ps((float)(RESPONSE_CURVE_LUT_SIZE - 1)));
+    __m128i idx = _mm_cvttps_epi32(pos);
+    __m128 frac = _mm_sub_ps(pos, _mm_cvtepi32_ps(idx));
+
+    // SSE2 沒有 gather，逐一讀取
+    int32_t lanes[4];
+    float lo[4], hi[4];
+    _mm_storeu_si128((__m128i *)lanes, idx);
+    for (int k = 0; k < 4; ++k) {
+        int j = lanes[k] < RESPONSE_CURVE_LUT_SIZE - 2 ? lanes[k] : RESPONSE_CURVE_LUT_SIZE - 2;
+        lo[k] = lut[j];
+        hi[k] = lut[j + 1];
+    }
+    __m128 a = _mm_loadu_ps(lo);
+    __m128 r = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hi), a), frac));
+    return mb_select_sse2(_mm_cmpge_ps(t, one), r, _mm_set1_ps(lut[RESPONSE_CURVE_LUT_SIZE - 1]));
+}
+
+// Cephes expf 多項式，相對誤差約 2 ulp
+static MB_SSE2_TARGET inline __m128 mb_exp_sse2(__m128 x)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-87.3f)), _mm_set1_ps(88.3f));
+
+    __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+    __m128 tr = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+    fx = _mm_sub_ps(tr, _mm_and_ps(_mm_cmpgt_ps(tr, fx), one)); // floor
+
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(1.9875691500e-4f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), one);
+
+    __m128i n = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(127));
+    return _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(n, 23)));
+}
+
+#define MB_FN(name) name##_sse2
+#define MB_TARGET MB_SSE2_TARGET
+#define MB_WIDTH 4
+#define vf __m128
+#define vf_set1 _mm_set1_ps
+#define vf_load _mm_loadu_ps
+#define vf_store _mm_storeu_ps
+#define vf_add _mm_add_ps
+#define vf_sub _mm_sub_ps
+#define vf_mul _mm_mul_ps
+#define vf_div _mm_div_ps
+#define vf_min _mm_min_ps
+#define vf_max _mm_max_ps
+#define vf_sqrt _mm_sqrt_ps
+#define vf_abs(a) _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+#define vf_lt _mm_cmplt_ps
+#define vf_le _mm_cmple_ps
+#define vf_gt _mm_cmpgt_ps
+#define vf_and _mm_and_ps
+#define vf_select mb_select_sse2
+#define mb_curve mb_curve_sse2
+#define mb_exp mb_exp_sse2
+#include "motion_batch_simd.h"
+#undef MB_FN
+#undef MB_TARGET
+#undef MB_WIDTH
+#undef vf
+#undef vf_set1
+#undef vf_load
+#undef vf_store
+#undef vf_add
+#undef vf_sub
+#undef vf_mul
+#undef vf_div
+#undef vf_min
+#undef vf_max
+#undef vf_sqrt
+#undef vf_abs
+#undef vf_lt
+#undef vf_le
+#undef vf_gt
+#undef vf_and
+#undef vf_select
+#undef mb_curve
+#undef mb_exp
+
+// ---------------------------------------------------------------------------
+// AVX2
+
+static MB_AVX2_TARGET inline __m256 mb_select_avx2(__m256 mask, __m256 a, __m256 b)
+{
+    return _mm256_blendv_ps(a, b, mask);
+}
+
+static MB_AVX2_TARGET inline __m256 mb_curve_avx2(const float *lut, __m256 t)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 clamped = _mm256_min_ps(_mm256_max_ps(t, _mm256_setzero_ps()), one);
+    __m256 pos = _mm256_mul_ps(clamped, _mm256_set1_ps((float)(RESPONSE_CURVE_LUT_SIZE - 1)));
+    __m256i idx = _mm256_cvttps_epi32(pos);
+    __m256 frac = _mm256_sub_ps(pos, _mm256_cvtepi32_ps(idx));
+
+    idx = _mm256_min_epi32(idx, _mm256_set1_epi32(RESPONSE_CURVE_LUT_SIZE - 2));
+    __m256 a = _mm256_i32gather_ps(lut, idx, 4);
+    __m256 b = _mm256_i32gather_ps(lut + 1, idx, 4);
+    __m256 r = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), frac));
+    return mb_select_avx2(_mm256_cmp_ps(t, one, _CMP_GE_OQ), r, _mm256_set1_ps(lut[RESPONSE_CURVE_LUT_SIZE - 1]));
+}
+
+static MB_AVX2_TARGET inline __m256 mb_exp_avx2(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-87.3f)), _mm256_set1_ps(88.3f));
+
+    __m256 fx = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)), _mm256_set1_ps(0.5f));
+    fx = _mm256_floor_ps(fx);
+
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(0.693359375f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(-2.12194440e-4f)));
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.3981999507e-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(8.3334519073e-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(4.1665795894e-2f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.6666665459e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(5.0000001201e-1f));
+    y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, z), x), one);
+
+    __m256i n = _mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127));
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(n, 23)));
+}
+
+#define MB_FN(name) name##_avx2
+#define MB_TARGET MB_AVX2_TARGET
+#define MB_WIDTH 8
+#define vf __m256
+#define vf_set1 _mm256_set1_ps
+#define vf_load _mm256_loadu_ps
+#define vf_store _mm256_storeu_ps
+#define vf_add _mm256_add_ps
+#define vf_sub _mm256_sub_ps
+#define vf_mul _mm256_mul_ps
+#define vf_div _mm256_div_ps
+#define vf_min _mm256_min_ps
+#define vf_max _mm256_max_ps
+#define vf_sqrt _mm256_sqrt_ps
+#define vf_abs(a) _mm256_andnot_ps(_mm256_set1_ps(-0.0f), (a))
+#define vf_lt(a, b) _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define vf_le(a, b) _mm256_cmp_ps((a), (b), _CMP_LE_OQ)
+#define vf_gt(a, b) _mm256_cmp_ps((a), (b), _CMP_GT_OQ)
+#define vf_and _mm256_and_ps
+#define vf_select mb_select_avx2
+#define mb_curve mb_curve_avx2
+#define mb_exp mb_exp_avx2
+#include "motion_batch_simd.h"
+#undef MB_FN
+#undef MB_TARGET
+#undef MB_WIDTH
+#undef vf
+#undef vf_set1
+#undef vf_load
+#undef vf_store
+#undef vf_add
+#undef vf_sub
+#undef vf_mul
+#undef vf_div
+#undef vf_min
+#undef vf_max
+#undef vf_sqrt
+#undef vf_abs
+#undef vf_lt
+#undef vf_le
+#undef vf_gt
+#undef vf_and
+#undef vf_select
+#undef mb_curve
+#undef mb_exp
+
+static bool cpu_has_avx2(void)
+{
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    // 需要作業系統保存 YMM 暫存器
+    if (!(regs[2] & (1 << 27)) || !(regs[2] & (1 << 28))) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif // MOTION_BATCH_X86
+
+// ---------------------------------------------------------------------------
+
+enum motion_batch_isa motion_batch_resolve_isa(enum motion_batch_isa isa)
+{
+#ifdef MOTION_BATCH_X86
+    bool avx2 = cpu_has_avx2();
+    if (isa == MOTION_BATCH_ISA_AUTO) return avx2 ? MOTION_BATCH_ISA_AVX2 : MOTION_BATCH_ISA_SSE2;
+    if (isa == MOTION_BATCH_ISA_AVX2 && !avx2) return MOTION_BATCH_ISA_SSE2;
+    return isa;
+#else
+    (void)isa;
+    return MOTION_BATCH_ISA_SCALAR;
+#endif
+}
+
+const char *motion_batch_isa_name(enum motion_batch_isa isa)
+{
+    switch (isa) {
+    case MOTION_BATCH_ISA_SCALAR: return "scalar";
+    case MOTION_BATCH_ISA_SSE2: return "sse2";
+    case MOTION_BATCH_ISA_AVX2: return "avx2";
+    default: return "auto";
+    }
+}
+
+bool motion_batch_init(struct motion_batch *batch, size_t count, enum motion_batch_isa isa)
+{
+    memset(batch, 0, sizeof(*batch));
+    batch->count = count;
+    batch->stride = (count + MOTION_BATCH_ALIGN - 1) / MOTION_BATCH_ALIGN * MOTION_BATCH_ALIGN;
+    batch->isa = motion_batch_resolve_isa(isa);
+
+    // 所有欄位配置在同一塊記憶體，補齊的 lane 保持為 0
+    float **fields[] = {
+        &batch->sensitivity, &batch->move_speed_center, &batch->move_speed_edge, &batch->recenter_center,
+        &batch->recenter_edge, &batch->max_offset, &batch->idle_enabled, &batch->idle_delay, &batch->idle_ramp,
+        &batch->idle_boost, &batch->settle_threshold, &batch->offset_x, &batch->offset_y, &batch->idle_time,
+        &batch->dir_x, &batch->dir_y, &batch->pending, &batch->settle_time, &batch->overshoot,
+        &batch->peak_offset,
+    };
+    size_t field_count = sizeof(fields) / sizeof(fields[0]);
+    float *block = calloc(field_count * batch->stride, sizeof(float));
+    if (!block) return false;
+    for (size_t i = 0; i < field_count; ++i) *fields[i] = block + i * batch->stride;
+    return true;
+}
+
+void motion_batch_free(struct motion_batch *batch)
+{
+    free(batch->sensitivity); // 整塊記憶體的起點
+    memset(batch, 0, sizeof(*batch));
+}
+
+void motion_batch_params(const struct motion_batch *batch, size_t lane, struct motion_params *params)
+{
+    params->sensitivity = batch->sensitivity[lane];
+    params->move_speed_center = batch->move_speed_center[lane];
+    params->move_speed_edge = batch->move_speed_edge[lane];
+    params->recenter_speed_center = batch->recenter_center[lane];
+    params->recenter_speed_edge = batch->recenter_edge[lane];
+    params->max_offset = batch->max_offset[lane];
+    params->idle_recenter = batch->idle_enabled[lane] > 0.0f;
+    params->idle_delay = batch->idle_delay[lane];
+    params->idle_ramp = batch->idle_ramp[lane];
+    params->idle_boost = batch->idle_boost[lane];
+    params->move_curve = batch->move_curve;
+    params->recenter_curve = batch->recenter_curve;
+    params->idle_curve = batch->idle_curve;
+}
+
+void motion_batch_reset(struct motion_batch *batch)
+{
+    float *state[] = {
+        batch->offset_x, batch->offset_y, batch->idle_time, batch->dir_x, batch->dir_y,
+        batch->pending, batch->settle_time, batch->overshoot, batch->peak_offset,
+    };
+    for (size_t i = 0; i < sizeof(state) / sizeof(state[0]); ++i) {
+        memset(state[i], 0, sizeof(float) * batch->stride);
+    }
+    batch->last_input_time = 0.0;
+}
+
+void motion_batch_steps(struct motion_batch *batch, uint64_t n, double first_time)
+{
+    if (n == 0) return;
+    switch (batch->isa) {
+#ifdef MOTION_BATCH_X86
+    case MOTION_BATCH_ISA_AVX2:
+        motion_batch_steps_avx2(batch, n, first_time);
+        break;
+    case MOTION_BATCH_ISA_SSE2:
+        motion_batch_steps_sse2(batch, n, first_time);
+        break;
+#endif
+    default:
+        motion_batch_steps_scalar(batch, n, first_time);
+        break;
+    }
+}
+
+void motion_batch_input(struct motion_batch *batch, float dx, float dy, double time)
+{
+    if (dx == 0.0f && dy == 0.0f) return; // 與 motion_apply_input 相同：沒有位移時不重設靜止時間
+    batch->last_input_time = time;
+    switch (batch->isa) {
+#ifdef MOTION_BATCH_X86
+    case MOTION_BATCH_ISA_AVX2:
+        motion_batch_input_avx2(batch, dx, dy);
+        break;
+    case MOTION_BATCH_ISA_SSE2:
+        motion_batch_input_sse2(batch, dx, dy);
+        break;
+#endif
+    default:
+        motion_batch_input_scalar(batch, dx, dy);
+        break;
+    }
+}
+
+void motion_batch_add_idle(struct motion_batch *batch, float seconds)
+{
+    for (size_t i = 0; i < batch->stride; ++i) batch->idle_time[i] += seconds;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../motion.h"
+
+// 移動模型的批次模擬
+// 每個 lane 是一組參數；所有 lane 共用同一段輸入紀錄與固定步長時間軸，
+// 因此每一步對所有 lane 都相同，可以用 SSE2 / AVX2 一次處理 4 / 8 組參數。
+// 純量路徑直接呼叫 motion_step / motion_apply_input，與插件的結果逐位元相同；
+// SIMD 路徑只有 exp 使用多項式近似，誤差以 --verify 量測。
+
+enum motion_batch_isa {
+    MOTION_BATCH_ISA_AUTO = 0,
+    MOTION_BATCH_ISA_SCALAR,
+    MOTION_BATCH_ISA_SSE2,
+    MOTION_BATCH_ISA_AVX2,
+};
+
+// 輸入紀錄的一筆滑鼠位移
+struct motion_event {
+    uint64_t timestamp; // 奈秒
+    float dx;
+    float dy;
+};
+
+struct motion_batch {
+    size_t count;  // 參數組數量
+    size_t stride; // 補齊到 8 的倍數，SIMD 迴圈不需處理尾端
+    enum motion_batch_isa isa;
+
+    // 參數（SoA）
+    float *sensitivity;
+    float *move_speed_center;
+    float *move_speed_edge;
+    float *recenter_center;
+    float *recenter_edge;
+    float *max_offset;
+    float *idle_enabled; // 1 = 啟用靜止回彈加速
+    float *idle_delay;
+    float *idle_ramp;
+    float *idle_boost;
+    float *settle_threshold; // 判定已回到中心的距離（像素）
+    const struct response_curve *move_curve;
+    const struct response_curve *recenter_curve;
+    const struct response_curve *idle_curve;
+
+    // 狀態
+    float *offset_x;
+    float *offset_y;
+    float *idle_time;
+
+    // 統計
+    float *dir_x;        // 最後一次輸入後的偏移方向，用來偵測越過中心
+    float *dir_y;
+    float *pending;      // 1 = 最後一次輸入後尚未回到中心
+    float *settle_time;  // 最長的回中時間（秒）
+    float *overshoot;    // 越過中心的最大距離（像素）
+    float *peak_offset;  // 最大偏移距離（像素）
+    double last_input_time; // 最後一次輸入的時間（秒）
+};
+
+bool motion_batch_init(struct motion_batch *batch, size_t count, enum motion_batch_isa isa);
+void motion_batch_free(struct motion_batch *batch);
+// 實際使用的指令集（AUTO 會依 CPU 支援選擇）
+enum motion_batch_isa motion_batch_resolve_isa(enum motion_batch_isa isa);
+const char *motion_batch_isa_name(enum motion_batch_isa isa);
+
+// 以 lane 的參數建立插件使用的 motion_params（純量參考路徑）
+void motion_batch_params(const struct motion_batch *batch, size_t lane, struct motion_params *params);
+
+// 重設狀態與統計
+void motion_batch_reset(struct motion_batch *batch);
+// 執行 n 個固定步長；第一步結束於 first_time 秒，之後每步加 MOTION_STEP_SECONDS
+void motion_batch_steps(struct motion_batch *batch, uint64_t n, double first_time);
+// 所有 lane 在 time 秒套用同一筆位移
+void motion_batch_input(struct motion_batch *batch, float dx, float dy, double time);
+// 所有 lane 的靜止時間增加相同的量（對應 motion_advance 的長時間補償）
+void motion_batch_add_idle(struct motion_batch *batch, float seconds);
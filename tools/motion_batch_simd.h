@@ -0,0 +1,131 @@
+// 批次模擬的 SIMD 核心範本，由 motion_batch.c 以不同指令集展開
+// 展開前需定義：
+//   MB_FN(name)  函式名稱後綴
+//   MB_TARGET    函式的目標指令集屬性
+//   MB_WIDTH     每個向量的 lane 數
+//   vf           浮點向量型別
+//   vf_set1 / vf_load / vf_store / vf_add / vf_sub / vf_mul / vf_div / vf_min / vf_max / vf_sqrt
+//   vf_abs / vf_lt / vf_le / vf_gt（回傳遮罩）/ vf_and / vf_select(mask, a, b)（遮罩為真取 b）
+//   mb_curve(lut, t)  查表內插，語意與 response_curve_eval 相同
+//   mb_exp(x)         exp 近似
+// 運算順序刻意與 motion.c 相同，讓除了 exp 以外的結果逐位元一致。
+
+static MB_TARGET void MB_FN(motion_batch_steps)(struct motion_batch *b, uint64_t n, double first_time)
+{
+    const double step_seconds = (double)MOTION_STEP_NS / 1000000000.0;
+    const vf zero = vf_set1(0.0f);
+    const vf one = vf_set1(1.0f);
+    const vf step = vf_set1(MOTION_STEP_SECONDS);
+    const vf neg_step = vf_set1(-MOTION_STEP_SECONDS);
+    const float *recenter_lut = b->recenter_curve->lut;
+    const float *idle_lut = b->idle_curve->lut;
+
+    for (size_t i = 0; i < b->stride; i += MB_WIDTH) {
+        vf ox = vf_load(b->offset_x + i);
+        vf oy = vf_load(b->offset_y + i);
+        vf idle = vf_load(b->idle_time + i);
+        const vf rc = vf_load(b->recenter_center + i);
+        const vf re = vf_load(b->recenter_edge + i);
+        const vf max_offset = vf_load(b->max_offset + i);
+        const vf has_max = vf_gt(max_offset, zero);
+        const vf idle_on = vf_gt(vf_load(b->idle_enabled + i), zero);
+        const vf delay = vf_load(b->idle_delay + i);
+        const vf ramp = vf_load(b->idle_ramp + i);
+        const vf has_ramp = vf_gt(ramp, zero);
+        const vf boost_max = vf_load(b->idle_boost + i);
+        const vf thr = vf_load(b->settle_threshold + i);
+        const vf thr2 = vf_mul(thr, thr);
+        const vf dir_x = vf_load(b->dir_x + i);
+        const vf dir_y = vf_load(b->dir_y + i);
+        vf pending = vf_load(b->pending + i);
+        vf settle = vf_load(b->settle_time + i);
+        vf overshoot = vf_load(b->overshoot + i);
+
+        for (uint64_t s = 0; s < n; ++s) {
+            // 距離中心的比例
+            vf distance = vf_sqrt(vf_add(vf_mul(ox, ox), vf_mul(oy, oy)));
+            vf normalized = vf_select(has_max, zero, vf_div(distance, max_offset));
+            normalized = vf_min(normalized, one);
+
+            // 靜止加速：未啟用或仍在延遲內為 0
+            vf in_delay = vf_and(vf_gt(delay, zero), vf_lt(idle, delay));
+            vf progress = vf_min(vf_div(vf_sub(idle, delay), ramp), one);
+            progress = vf_select(has_ramp, one, progress);
+            vf boost = vf_mul(boost_max, mb_curve(idle_lut, progress));
+            boost = vf_select(idle_on, zero, boost);
+            boost = vf_select(in_delay, boost, zero);
+
+            vf center = vf_add(rc, boost);
+            vf edge = vf_add(re, boost);
+            vf speed = vf_add(center, vf_mul(vf_sub(edge, center), mb_curve(recenter_lut, normalized)));
+            speed = vf_select(vf_lt(speed, zero), speed, zero);
+
+            vf factor = vf_select(vf_gt(speed, zero), one, mb_exp(vf_mul(speed, neg_step)));
+            ox = vf_mul(ox, factor);
+            oy = vf_mul(oy, factor);
+            idle = vf_add(idle, step);
+
+            // 統計：回到中心的時間與越過中心的距離
+            vf since = vf_set1((float)(first_time + (double)s * step_seconds - b->last_input_time));
+            vf settled = vf_and(vf_gt(pending, zero), vf_le(vf_add(vf_mul(ox, ox), vf_mul(oy, oy)), thr2));
+            settle = vf_select(settled, settle, vf_max(settle, since));
+            pending = vf_select(settled, pending, zero);
+            vf cross_x = vf_lt(vf_mul(ox, dir_x), zero);
+            vf cross_y = vf_lt(vf_mul(oy, dir_y), zero);
+            overshoot = vf_select(cross_x, overshoot, vf_max(overshoot, vf_abs(ox)));
+            overshoot = vf_select(cross_y, overshoot, vf_max(overshoot, vf_abs(oy)));
+        }
+
+        vf_store(b->offset_x + i, ox);
+        vf_store(b->offset_y + i, oy);
+        vf_store(b->idle_time + i, idle);
+        vf_store(b->pending + i, pending);
+        vf_store(b->settle_time + i, settle);
+        vf_store(b->overshoot + i, overshoot);
+    }
+}
+
+static MB_TARGET void MB_FN(motion_batch_input)(struct motion_batch *b, float dx, float dy)
+{
+    const vf zero = vf_set1(0.0f);
+    const vf one = vf_set1(1.0f);
+    const vf vdx = vf_set1(dx);
+    const vf vdy = vf_set1(dy);
+    const float *move_lut = b->move_curve->lut;
+
+    for (size_t i = 0; i < b->stride; i += MB_WIDTH) {
+        vf ox = vf_load(b->offset_x + i);
+        vf oy = vf_load(b->offset_y + i);
+        const vf max_offset = vf_load(b->max_offset + i);
+        const vf sensitivity = vf_load(b->sensitivity + i);
+        const vf msc = vf_load(b->move_speed_center + i);
+        const vf mse = vf_load(b->move_speed_edge + i);
+
+        vf distance = vf_sqrt(vf_add(vf_mul(ox, ox), vf_mul(oy, oy)));
+        vf normalized = vf_select(vf_gt(max_offset, zero), zero, vf_div(distance, max_offset));
+        normalized = vf_min(normalized, one);
+
+        vf t = mb_curve(move_lut, normalized);
+        vf move_speed = vf_add(msc, vf_mul(vf_sub(mse, msc), t));
+        move_speed = vf_select(vf_lt(move_speed, zero), move_speed, zero);
+
+        ox = vf_add(ox, vf_mul(vf_mul(vdx, sensitivity), move_speed));
+        oy = vf_add(oy, vf_mul(vf_mul(vdy, sensitivity), move_speed));
+        vf neg_max = vf_mul(max_offset, vf_set1(-1.0f));
+        ox = vf_max(vf_min(ox, max_offset), neg_max);
+        oy = vf_max(vf_min(oy, max_offset), neg_max);
+
+        vf_store(b->offset_x + i, ox);
+        vf_store(b->offset_y + i, oy);
+        vf_store(b->idle_time + i, zero);
+        vf_store(b->dir_x + i, ox);
+        vf_store(b->dir_y + i, oy);
+        // 只有離開中心範圍的輸入才需要計算回中時間
+        vf mag2 = vf_add(vf_mul(ox, ox), vf_mul(oy, oy));
+        vf thr = vf_load(b->settle_threshold + i);
+        vf pending = vf_load(b->pending + i);
+        vf_store(b->pending + i, vf_select(vf_gt(mag2, vf_mul(thr, thr)), pending, one));
+        vf peak = vf_load(b->peak_offset + i);
+        vf_store(b->peak_offset + i, vf_max(peak, vf_sqrt(mag2)));
+    }
+}
@@ -0,0 +1,218 @@
+// motion_golden：移動模式的黃金輸出測試
+//
+// 以固定的輸入紀錄（1 kHz 取樣的幾次甩動與之後的靜止回彈）依 30 / 60 / 144 fps 的幀時間驅動插件的
+// motion_advance / motion_apply_input，與插件 tick 的順序相同：先處理到該幀為止的樣本，再推進到幀時間。
+// 三種幀率在共同的時間點（每 1/6 秒）取樣偏移，與儲存的黃金位置比對，誤差超過容許值即失敗。
+// 用法：motion_golden [--tolerance PX] [--update] GOLDEN.csv
+//   --update 以目前的實作重新產生黃金檔（移動模型有意變更時使用）
+
+#include "../motion.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GOLDEN_SAMPLE_NS 1000000ULL          // 取樣執行緒 1 kHz
+#define GOLDEN_DURATION_NS 4000000000ULL     // 模擬 4 秒，包含靜止回彈加速
+#define GOLDEN_CHECKPOINTS 24                // 每 1/6 秒一個檢查點：30、60、144 fps 都有幀落在此
+#define GOLDEN_MAX_EVENTS 4096
+
+struct golden_event {
+    uint64_t timestamp;
+    float dx;
+    float dy;
+};
+
+struct golden_point {
+    double x;
+    double y;
+};
+
+// 固定的甩動：開始時間、長度（毫秒）與方向；速度為半個正弦波
+static const struct {
+    int start_ms;
+    int length_ms;
+    float dx;
+    float dy;
+} golden_flicks[] = {
+    {0, 150, 8.0f, 0.0f},
+    {600, 100, -5.0f, -6.0f},
+    {1500, 120, 0.0f, 9.0f},
+    {1700, 40, 12.0f, 12.0f},
+};
+
+static size_t golden_trace(struct golden_event *events)
+{
+    size_t n = 0;
+    for (size_t f = 0; f < sizeof(golden_flicks) / sizeof(golden_flicks[0]); ++f) {
+        for (int ms = 0; ms < golden_flicks[f].length_ms && n < GOLDEN_MAX_EVENTS; ++ms) {
+            float s = sinf(3.14159265f * (float)ms / (float)golden_flicks[f].length_ms);
+            float dx = roundf(golden_flicks[f].dx * s);
+            float dy = roundf(golden_flicks[f].dy * s);
+            if (dx == 0.0f && dy == 0.0f) continue; // 取樣執行緒只在移動時寫入
+            events[n].timestamp = (uint64_t)(golden_flicks[f].start_ms + ms) * GOLDEN_SAMPLE_NS;
+            events[n].dx = dx;
+            events[n].dy = dy;
+            n++;
+        }
+    }
+    return n;
+}
+
+// 插件的預設設定（dr_cursor_tracker.c 的 get_defaults）
+static void golden_params(struct motion_params *params, struct response_curve *move, struct response_curve *recenter,
+                          struct response_curve *idle)
+{
+    response_curve_bake(move, RESPONSE_CURVE_CONSTANT, NULL);
+    response_curve_bake(recenter, RESPONSE_CURVE_LINEAR, NULL);
+    response_curve_bake(idle, RESPONSE_CURVE_LINEAR, NULL);
+    memset(params, 0, sizeof(*params));
+    params->sensitivity = 0.25f;
+    params->move_speed_center = 1.0f;
+    params->move_speed_edge = 0.05f;
+    params->recenter_speed_center = 0.75f;
+    params->recenter_speed_edge = 1.5f;
+    params->max_offset = 200.0f;
+    params->idle_recenter = true;
+    params->idle_delay = 0.1f;
+    params->idle_ramp = 2.0f;
+    params->idle_boost = 10.0f;
+    params->move_curve = move;
+    params->recenter_curve = recenter;
+    params->idle_curve = idle;
+}
+
+static uint64_t checkpoint_ns(int index)
+{
+    return (uint64_t)(index + 1) * 1000000000ULL / 6;
+}
+
+// 依幀率逐幀推進，記錄落在檢查點上的幀的偏移
+static bool golden_run(int fps, const struct golden_event *events, size_t count,
+                       struct golden_point points[GOLDEN_CHECKPOINTS])
+{
+    struct response_curve move, recenter, idle;
+    struct motion_params params;
+    golden_params(&params, &move, &recenter, &idle);
+
+    struct motion_state state;
+    motion_init(&state, 0.0f, 0.0f);
+    motion_advance(&state, &params, 0);
+
+    size_t next = 0;
+    int checkpoint = 0;
+    for (uint64_t frame = 1; checkpoint < GOLDEN_CHECKPOINTS; ++frame) {
+        uint64_t now_ns = frame * 1000000000ULL / (uint64_t)fps;
+        if (now_ns > GOLDEN_DURATION_NS) break;
+        for (; next < count && events[next].timestamp <= now_ns; ++next) {
+            motion_advance(&state, &params, events[next].timestamp);
+            motion_apply_input(&state, &params, events[next].dx, events[next].dy);
+        }
+        motion_advance(&state, &params, now_ns);
+
+        if (now_ns == checkpoint_ns(checkpoint)) {
+            points[checkpoint].x = state.offset_x;
+            points[checkpoint].y = state.offset_y;
+            checkpoint++;
+        }
+    }
+    return checkpoint == GOLDEN_CHECKPOINTS;
+}
+
+static bool golden_load(const char *path, struct golden_point points[GOLDEN_CHECKPOINTS])
+{
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+
+    char line[256];
+    int n = 0;
+    while (fgets(line, sizeof(line), file) && n < GOLDEN_CHECKPOINTS) {
+        if (line[0] == '#' || line[0] == 't') continue; // 註解與標題列
+        int ms;
+        if (sscanf(line, "%d,%lf,%lf", &ms, &points[n].x, &points[n].y) == 3) n++;
+    }
+    fclose(file);
+    return n == GOLDEN_CHECKPOINTS;
+}
+
+static bool golden_save(const char *path, const struct golden_point points[GOLDEN_CHECKPOINTS])
+{
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "# motion_golden 產生的黃金位置：插件預設設定，1 kHz 輸入，每 1/6 秒一個檢查點\n");
+    fprintf(file, "time_ms,offset_x,offset_y\n");
+    for (int i = 0; i < GOLDEN_CHECKPOINTS; ++i) {
+        fprintf(file, "%d,%.6f,%.6f\n", (int)(checkpoint_ns(i) / 1000000ULL), points[i].x, points[i].y);
+    }
+    return fclose(file) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    static const int frame_rates[] = {30, 60, 144};
+    const char *path = NULL;
+    double tolerance = 0.01;
+    bool update = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--update")) {
+            update = true;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [--tolerance PX] [--update] GOLDEN.csv\n", argv[0]);
+        return 1;
+    }
+
+    static struct golden_event events[GOLDEN_MAX_EVENTS];
+    size_t count = golden_trace(events);
+
+    struct golden_point golden[GOLDEN_CHECKPOINTS];
+    if (update) {
+        if (!golden_run(frame_rates[0], events, count, golden) || !golden_save(path, golden)) {
+            fprintf(stderr, "無法產生黃金檔 %s\n", path);
+            return 1;
+        }
+        printf("已寫入 %s\n", path);
+        return 0;
+    }
+    if (!golden_load(path, golden)) {
+        fprintf(stderr, "無法讀取黃金檔 %s（需要 %d 個檢查點）\n", path, GOLDEN_CHECKPOINTS);
+        return 1;
+    }
+
+    bool failed = false;
+    printf("fps,max_error_px,result\n");
+    for (size_t f = 0; f < sizeof(frame_rates) / sizeof(frame_rates[0]); ++f) {
+        struct golden_point points[GOLDEN_CHECKPOINTS];
+        if (!golden_run(frame_rates[f], events, count, points)) {
+            fprintf(stderr, "%d fps：幀時間沒有落在所有檢查點上\n", frame_rates[f]);
+            failed = true;
+            continue;
+        }
+
+        double max_error = 0.0;
+        for (int i = 0; i < GOLDEN_CHECKPOINTS; ++i) {
+            double ex = fabs(points[i].x - golden[i].x);
+            double ey = fabs(points[i].y - golden[i].y);
+            double error = ex > ey ? ex : ey;
+            if (error > tolerance) {
+                fprintf(stderr, "%d fps @ %d ms：(%.4f, %.4f)，預期 (%.4f, %.4f)\n", frame_rates[f],
+                        (int)(checkpoint_ns(i) / 1000000ULL), points[i].x, points[i].y, golden[i].x, golden[i].y);
+            }
+            if (error > max_error) max_error = error;
+        }
+        bool ok = max_error <= tolerance;
+        failed = failed || !ok;
+        printf("%d,%.6f,%s\n", frame_rates[f], max_error, ok ? "ok" : "FAIL");
+    }
+    return failed ? 2 : 0;
+}
@@ -0,0 +1,438 @@
+// motion_sweep：以錄製的輸入紀錄批次模擬移動模式的參數組合
+//
+// 對每一組參數輸出回中時間、越過中心的距離與最大偏移，取代在直播中反覆試調。
+// 用法請見 usage() 或 docs/SETTINGS_GUIDE_TW.md 的「參數掃描工具」一節。
+
+#include "motion_batch.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct sweep_range {
+    float min;
+    float max;
+    int count;
+};
+
+enum sweep_param {
+    SWEEP_SENSITIVITY,
+    SWEEP_MOVE_CENTER,
+    SWEEP_MOVE_EDGE,
+    SWEEP_RECENTER_CENTER,
+    SWEEP_RECENTER_EDGE,
+    SWEEP_IDLE_DELAY,
+    SWEEP_IDLE_TIME,
+    SWEEP_IDLE_BOOST,
+    SWEEP_PARAM_COUNT,
+};
+
+// 命令列名稱、CSV 欄位與預設值（與插件的預設設定相同）
+static const struct {
+    const char *option;
+    const char *column;
+    struct sweep_range range;
+} sweep_params[SWEEP_PARAM_COUNT] = {
+    {"--sensitivity", "sensitivity", {0.25f, 0.25f, 1}},
+    {"--move-center", "move_speed_center", {1.0f, 1.0f, 1}},
+    {"--move-edge", "move_speed_edge", {0.05f, 0.05f, 1}},
+    {"--recenter-center", "recenter_speed_center", {0.75f, 0.75f, 1}},
+    {"--recenter-edge", "recenter_speed_edge", {1.5f, 1.5f, 1}},
+    {"--idle-delay", "idle_recenter_delay", {0.1f, 0.1f, 1}},
+    {"--idle-time", "idle_recenter_time", {2.0f, 2.0f, 1}},
+    {"--idle-boost", "idle_recenter_boost", {10.0f, 10.0f, 1}},
+};
+
+struct sweep_options {
+    struct sweep_range ranges[SWEEP_PARAM_COUNT];
+    const char *trace_path;
+    float synthetic_seconds;
+    float tail_seconds;
+    float max_offset;
+    float settle_ratio;
+    bool idle_enabled;
+    int move_curve;
+    int recenter_curve;
+    int idle_curve;
+    enum motion_batch_isa isa;
+    bool verify;
+    float tolerance;
+    const char *output_path;
+};
+
+static void usage(void)
+{
+    fprintf(stderr,
+        "用法: motion_sweep [選項]\n"
+        "  --trace FILE          輸入紀錄，每行為 \"timestamp_ns dx dy\"，# 開頭為註解\n"
+        "  --synthetic SECONDS   不使用紀錄，產生固定的甩動測試輸入（預設 30 秒）\n"
+        "  --tail SECONDS        最後一筆輸入後繼續模擬的時間（預設 3）\n"
+        "  --max-offset PX       最大偏移（預設 200）\n"
+        "  --settle RATIO        偏移小於 max-offset * RATIO 視為回到中心（預設 0.01）\n"
+        "  --no-idle             停用靜止回彈加速\n"
+        "  --move-curve N        移速曲線預設值（0 固定、1 線性、2 緩入、3 緩出、4 緩入緩出；預設 0）\n"
+        "  --recenter-curve N    回彈曲線預設值（預設 1）\n"
+        "  --idle-curve N        靜止加速曲線預設值（預設 1）\n"
+        "  --isa auto|scalar|sse2|avx2\n"
+        "  --verify              以插件的純量路徑逐筆比對結果\n"
+        "  --tolerance PX        --verify 允許的最大偏移誤差（預設 0.001）\n"
+        "  --output FILE         CSV 輸出檔（預設 stdout）\n"
+        "參數範圍以 MIN:MAX:COUNT 或單一數值指定，所有範圍取笛卡兒積：\n"
+        "  --sensitivity --move-center --move-edge --recenter-center --recenter-edge\n"
+        "  --idle-delay --idle-time --idle-boost\n");
+}
+
+static bool parse_range(const char *text, struct sweep_range *range)
+{
+    float min, max;
+    int count;
+    if (sscanf(text, "%f:%f:%d", &min, &max, &count) == 3 && count >= 1) {
+        range->min = min;
+        range->max = max;
+        range->count = count;
+        return true;
+    }
+    if (sscanf(text, "%f", &min) == 1) {
+        range->min = range->max = min;
+        range->count = 1;
+        return true;
+    }
+    return false;
+}
+
+static float range_value(const struct sweep_range *range, int index)
+{
+    if (range->count <= 1) return range->min;
+    return range->min + (range->max - range->min) * (float)index / (float)(range->count - 1);
+}
+
+static bool parse_options(int argc, char **argv, struct sweep_options *opt)
+{
+    for (int p = 0; p < SWEEP_PARAM_COUNT; ++p) opt->ranges[p] = sweep_params[p].range;
+    opt->trace_path = NULL;
+    opt->synthetic_seconds = 30.0f;
+    opt->tail_seconds = 3.0f;
+    opt->max_offset = 200.0f;
+    opt->settle_ratio = 0.01f;
+    opt->idle_enabled = true;
+    opt->move_curve = RESPONSE_CURVE_CONSTANT;
+    opt->recenter_curve = RESPONSE_CURVE_LINEAR;
+    opt->idle_curve = RESPONSE_CURVE_LINEAR;
+    opt->isa = MOTION_BATCH_ISA_AUTO;
+    opt->verify = false;
+    opt->tolerance = 0.001f;
+    opt->output_path = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool matched = false;
+
+        for (int p = 0; p < SWEEP_PARAM_COUNT; ++p) {
+            if (strcmp(arg, sweep_params[p].option) != 0) continue;
+            if (!value || !parse_range(value, &opt->ranges[p])) return false;
+            matched = true;
+            i++;
+        }
+        if (matched) continue;
+
+        if (strcmp(arg, "--no-idle") == 0) {
+            opt->idle_enabled = false;
+        } else if (strcmp(arg, "--verify") == 0) {
+            opt->verify = true;
+        } else if (!value) {
+            return false;
+        } else if (strcmp(arg, "--trace") == 0) {
+            opt->trace_path = value;
+            i++;
+        } else if (strcmp(arg, "--synthetic") == 0) {
+            opt->synthetic_seconds = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--tail") == 0) {
+            opt->tail_seconds = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--max-offset") == 0) {
+            opt->max_offset = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--settle") == 0) {
+            opt->settle_ratio = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--move-curve") == 0) {
+            opt->move_curve = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--recenter-curve") == 0) {
+            opt->recenter_curve = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--idle-curve") == 0) {
+            opt->idle_curve = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--tolerance") == 0) {
+            opt->tolerance = strtof(value, NULL);
+            i++;
+        } else if (strcmp(arg, "--output") == 0) {
+            opt->output_path = value;
+            i++;
+        } else if (strcmp(arg, "--isa") == 0) {
+            if (strcmp(value, "auto") == 0) opt->isa = MOTION_BATCH_ISA_AUTO;
+            else if (strcmp(value, "scalar") == 0) opt->isa = MOTION_BATCH_ISA_SCALAR;
+            else if (strcmp(value, "sse2") == 0) opt->isa = MOTION_BATCH_ISA_SSE2;
+            else if (strcmp(value, "avx2") == 0) opt->isa = MOTION_BATCH_ISA_AVX2;
+            else return false;
+            i++;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 讀取輸入紀錄；時間戳需遞增，倒退的樣本會與插件一樣被忽略
+static struct motion_event *load_trace(const char *path, size_t *count)
+{
+    FILE *file = fopen(path, "r");
+    if (!file) return NULL;
+
+    size_t capacity = 4096, n = 0;
+    struct motion_event *events = malloc(sizeof(struct motion_event) * capacity);
+    char line[256];
+    while (events && fgets(line, sizeof(line), file)) {
+        unsigned long long ts;
+        float dx, dy;
+        if (line[0] == '#' || sscanf(line, "%llu %f %f", &ts, &dx, &dy) != 3) continue;
+        if (n == capacity) {
+            capacity *= 2;
+            struct motion_event *grown = realloc(events, sizeof(struct motion_event) * capacity);
+            if (!grown) {
+                free(events);
+                events = NULL;
+                break;
+            }
+            events = grown;
+        }
+        events[n].timestamp = (uint64_t)ts;
+        events[n].dx = dx;
+        events[n].dy = dy;
+        n++;
+    }
+    fclose(file);
+    *count = n;
+    return events;
+}
+
+// 固定的測試輸入：2 kHz 取樣，每 1.5 秒一次 120 ms 的甩動，方向與幅度以 LCG 產生
+static struct motion_event *synthetic_trace(float seconds, size_t *count)
+{
+    const uint64_t interval = 500000; // 2 kHz
+    const uint64_t flick_period = 1500000000ULL;
+    const uint64_t flick_length = 120000000ULL;
+    uint64_t duration = (uint64_t)(seconds * 1000000000.0);
+    size_t capacity = (size_t)(duration / interval) + 1;
+    struct motion_event *events = malloc(sizeof(struct motion_event) * capacity);
+    if (!events) return NULL;
+
+    uint32_t seed = 12345;
+    float dir_x = 1.0f, dir_y = 0.0f, amplitude = 0.0f;
+    size_t n = 0;
+    for (uint64_t t = 0; t < duration; t += interval) {
+        uint64_t phase = t % flick_period;
+        if (phase == 0) {
+            seed = seed * 1664525u + 1013904223u;
+            float angle = (float)(seed >> 8) / 16777216.0f * 6.2831853f;
+            seed = seed * 1664525u + 1013904223u;
+            amplitude = 2.0f + (float)(seed >> 8) / 16777216.0f * 8.0f;
+            dir_x = cosf(angle);
+            dir_y = sinf(angle);
+        }
+        float dx = 0.0f, dy = 0.0f;
+        if (phase < flick_length) {
+            // 半個正弦波的速度曲線：加速後減速
+            float s = sinf(3.14159265f * (float)phase / (float)flick_length);
+            dx = roundf(dir_x * amplitude * s);
+            dy = roundf(dir_y * amplitude * s);
+        }
+        if (dx == 0.0f && dy == 0.0f) continue; // 取樣執行緒只在移動時寫入
+        events[n].timestamp = t;
+        events[n].dx = dx;
+        events[n].dy = dy;
+        n++;
+    }
+    *count = n;
+    return events;
+}
+
+static void fill_batch(struct motion_batch *batch, const struct sweep_options *opt)
+{
+    for (size_t lane = 0; lane < batch->count; ++lane) {
+        // 以混合進位制把 lane 編號拆成各參數的索引
+        size_t rest = lane;
+        float values[SWEEP_PARAM_COUNT];
+        for (int p = SWEEP_PARAM_COUNT - 1; p >= 0; --p) {
+            int count = opt->ranges[p].count;
+            values[p] = range_value(&opt->ranges[p], (int)(rest % (size_t)count));
+            rest /= (size_t)count;
+        }
+        batch->sensitivity[lane] = values[SWEEP_SENSITIVITY];
+        batch->move_speed_center[lane] = values[SWEEP_MOVE_CENTER];
+        batch->move_speed_edge[lane] = values[SWEEP_MOVE_EDGE];
+        batch->recenter_center[lane] = values[SWEEP_RECENTER_CENTER];
+        batch->recenter_edge[lane] = values[SWEEP_RECENTER_EDGE];
+        batch->idle_delay[lane] = values[SWEEP_IDLE_DELAY];
+        batch->idle_ramp[lane] = values[SWEEP_IDLE_TIME];
+        batch->idle_boost[lane] = values[SWEEP_IDLE_BOOST];
+        batch->idle_enabled[lane] = opt->idle_enabled ? 1.0f : 0.0f;
+        batch->max_offset[lane] = opt->max_offset;
+        batch->settle_threshold[lane] = opt->max_offset * opt->settle_ratio;
+    }
+}
+
+// 驗證用：每個 lane 以插件的 motion_advance / motion_apply_input 獨立執行
+struct sweep_reference {
+    struct motion_state *states;
+    struct motion_params *params;
+    double max_error;
+};
+
+static void reference_step(struct sweep_reference *ref, const struct motion_batch *batch,
+                           const struct motion_event *event)
+{
+    for (size_t i = 0; i < batch->count; ++i) {
+        motion_advance(&ref->states[i], &ref->params[i], event->timestamp);
+        motion_apply_input(&ref->states[i], &ref->params[i], event->dx, event->dy);
+        double ex = fabs((double)ref->states[i].offset_x - (double)batch->offset_x[i]);
+        double ey = fabs((double)ref->states[i].offset_y - (double)batch->offset_y[i]);
+        if (ex > ref->max_error) ref->max_error = ex;
+        if (ey > ref->max_error) ref->max_error = ey;
+    }
+}
+
+// 與 motion_advance 相同的時間推進：累加器、固定步長與長時間補償
+static void run_trace(struct motion_batch *batch, const struct motion_event *events, size_t count,
+                      uint64_t tail_ns, struct sweep_reference *ref, uint64_t *total_steps)
+{
+    uint64_t origin = events[0].timestamp;
+    uint64_t time_ns = origin;
+    uint64_t accumulator = 0;
+    *total_steps = 0;
+
+    for (size_t e = 0; e <= count; ++e) {
+        // 最後加上一個沒有位移的事件，模擬輸入結束後的回中過程
+        struct motion_event event;
+        if (e < count) event = events[e];
+        else {
+            event.timestamp = events[count - 1].timestamp + tail_ns;
+            event.dx = event.dy = 0.0f;
+        }
+
+        if (event.timestamp > time_ns) {
+            uint64_t elapsed = event.timestamp - time_ns;
+            time_ns = event.timestamp;
+            if (elapsed > MOTION_MAX_CATCHUP_NS) {
+                motion_batch_add_idle(batch, (float)(elapsed - MOTION_MAX_CATCHUP_NS) / 1000000000.0f);
+                elapsed = MOTION_MAX_CATCHUP_NS;
+            }
+            accumulator += elapsed;
+            uint64_t n = accumulator / MOTION_STEP_NS;
+            accumulator -= n * MOTION_STEP_NS;
+            if (n > 0) {
+                // 第一步結束的時間點
+                uint64_t first_end = time_ns - accumulator - (n - 1) * MOTION_STEP_NS;
+                motion_batch_steps(batch, n, (double)(first_end - origin) / 1000000000.0);
+                *total_steps += n;
+            }
+        }
+        motion_batch_input(batch, event.dx, event.dy, (double)(event.timestamp - origin) / 1000000000.0);
+        if (ref) reference_step(ref, batch, &event);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    struct sweep_options opt;
+    if (!parse_options(argc, argv, &opt)) {
+        usage();
+        return 2;
+    }
+
+    size_t event_count = 0;
+    struct motion_event *events = opt.trace_path ? load_trace(opt.trace_path, &event_count)
+                                                 : synthetic_trace(opt.synthetic_seconds, &event_count);
+    if (!events || event_count == 0) {
+        fprintf(stderr, "無法取得輸入紀錄%s%s\n", opt.trace_path ? "：" : "", opt.trace_path ? opt.trace_path : "");
+        free(events);
+        return 1;
+    }
+
+    size_t lanes = 1;
+    for (int p = 0; p < SWEEP_PARAM_COUNT; ++p) lanes *= (size_t)opt.ranges[p].count;
+
+    struct response_curve move_curve, recenter_curve, idle_curve;
+    response_curve_bake(&move_curve, opt.move_curve, NULL);
+    response_curve_bake(&recenter_curve, opt.recenter_curve, NULL);
+    response_curve_bake(&idle_curve, opt.idle_curve, NULL);
+
+    struct motion_batch batch;
+    if (!motion_batch_init(&batch, lanes, opt.isa)) {
+        fprintf(stderr, "記憶體不足：%zu 組參數\n", lanes);
+        free(events);
+        return 1;
+    }
+    batch.move_curve = &move_curve;
+    batch.recenter_curve = &recenter_curve;
+    batch.idle_curve = &idle_curve;
+    fill_batch(&batch, &opt);
+    motion_batch_reset(&batch);
+
+    struct sweep_reference ref = {0};
+    if (opt.verify) {
+        ref.states = calloc(lanes, sizeof(struct motion_state));
+        ref.params = calloc(lanes, sizeof(struct motion_params));
+        if (!ref.states || !ref.params) {
+            fprintf(stderr, "記憶體不足：無法建立驗證用狀態\n");
+            return 1;
+        }
+        for (size_t i = 0; i < lanes; ++i) {
+            motion_init(&ref.states[i], 0.0f, 0.0f);
+            motion_batch_params(&batch, i, &ref.params[i]);
+        }
+    }
+
+    uint64_t total_steps = 0;
+    clock_t start = clock();
+    run_trace(&batch, events, event_count, (uint64_t)(opt.tail_seconds * 1000000000.0), opt.verify ? &ref : NULL,
+              &total_steps);
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    FILE *out = opt.output_path ? fopen(opt.output_path, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "無法寫入 %s\n", opt.output_path);
+        return 1;
+    }
+    for (int p = 0; p < SWEEP_PARAM_COUNT; ++p) fprintf(out, "%s,", sweep_params[p].column);
+    fprintf(out, "settle_time,overshoot,max_offset,unsettled\n");
+    for (size_t i = 0; i < lanes; ++i) {
+        fprintf(out, "%g,%g,%g,%g,%g,%g,%g,%g,%.4f,%.4f,%.4f,%d\n",
+                batch.sensitivity[i], batch.move_speed_center[i], batch.move_speed_edge[i], batch.recenter_center[i],
+                batch.recenter_edge[i], batch.idle_delay[i], batch.idle_ramp[i], batch.idle_boost[i],
+                batch.settle_time[i], batch.overshoot[i], batch.peak_offset[i], batch.pending[i] > 0.0f ? 1 : 0);
+    }
+    if (out != stdout) fclose(out);
+
+    fprintf(stderr, "%zu 組參數、%zu 筆輸入、%llu 步，指令集 %s，耗時 %.3f 秒（%.1f M lane-steps/s）\n", lanes,
+            event_count, (unsigned long long)total_steps, motion_batch_isa_name(batch.isa), elapsed,
+            elapsed > 0.0 ? (double)lanes * (double)total_steps / elapsed / 1e6 : 0.0);
+
+    int status = 0;
+    if (opt.verify) {
+        bool ok = ref.max_error <= opt.tolerance;
+        fprintf(stderr, "驗證：與插件純量路徑的最大偏移誤差 %.3g px（容許 %.3g px）%s\n", ref.max_error,
+                (double)opt.tolerance, ok ? "" : "，超出容許範圍");
+        status = ok ? 0 : 1;
+        free(ref.states);
+        free(ref.params);
+    }
+
+    motion_batch_free(&batch);
+    free(events);
+    return status;
+}
@@ -0,0 +1,224 @@
+// path_buffer_bench：比較路徑點的 SoA 環形緩衝區與原本的鏈結串列
+//
+// 以 1 kHz 產生路徑點、存活時間設為 N 毫秒，讓存活點數穩定在 N（預設 1k / 10k / 100k）。
+// 每一幀（60 fps）新增這一幀的點、清除過期點並走訪所有存活點（render 的讀取模式），分別量測：
+//   update：新增 + 過期清理；traverse：走訪所有存活點
+// 兩種實作每幀的存活點數與座標總和必須相同，否則回傳失敗。
+// 用法：path_buffer_bench [--frames N] [點數 ...]
+
+#include "../path_buffer.h"
+#include <util/bmem.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_NS 1000000ULL      // 每毫秒一個路徑點
+#define BENCH_FRAME_NS 16666667ULL      // 60 fps
+
+// 插件原本的路徑點：每個點各自配置的單向鏈結串列，過期清理走訪整個串列
+struct list_point {
+    float x;
+    float y;
+    uint64_t timestamp;
+    struct list_point *next;
+};
+
+struct list_path {
+    struct list_point *head;
+    struct list_point *tail;
+    int count;
+};
+
+static void list_push(struct list_path *path, float x, float y, uint64_t timestamp)
+{
+    struct list_point *point = bzalloc(sizeof(struct list_point));
+    point->x = x;
+    point->y = y;
+    point->timestamp = timestamp;
+    if (path->tail) {
+        path->tail->next = point;
+        path->tail = point;
+    } else {
+        path->head = path->tail = point;
+    }
+    path->count++;
+}
+
+static void list_expire(struct list_path *path, uint64_t now_ns, uint64_t lifetime_ns)
+{
+    struct list_point *cur = path->head;
+    struct list_point *prev = NULL;
+    while (cur) {
+        if (now_ns - cur->timestamp > lifetime_ns) {
+            struct list_point *next = cur->next;
+            if (prev) prev->next = next; else path->head = next;
+            if (cur == path->tail) path->tail = prev;
+            bfree(cur);
+            path->count--;
+            cur = next;
+        } else {
+            prev = cur;
+            cur = cur->next;
+        }
+    }
+}
+
+static void list_free(struct list_path *path)
+{
+    while (path->head) {
+        struct list_point *next = path->head->next;
+        bfree(path->head);
+        path->head = next;
+    }
+    path->tail = NULL;
+    path->count = 0;
+}
+
+static double list_traverse(const struct list_path *path)
+{
+    double sum = 0.0;
+    for (const struct list_point *p = path->head; p; p = p->next) sum += (double)p->x + (double)p->y;
+    return sum;
+}
+
+static double ring_traverse(const struct path_buffer *buf)
+{
+    double sum = 0.0;
+    for (int i = 0; i < buf->count; ++i) {
+        int idx = path_buffer_index(buf, i);
+        sum += (double)buf->x[idx] + (double)buf->y[idx];
+    }
+    return sum;
+}
+
+// 工具不連結 libobs：bmem 直接對應到 C 標準函式庫
+void *bmalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline float point_x(uint64_t n)
+{
+    return (float)(n % 1920);
+}
+
+static inline float point_y(uint64_t n)
+{
+    return (float)((n * 7) % 1080);
+}
+
+struct bench_result {
+    double update_us;
+    double traverse_us;
+};
+
+// 先填滿到穩定的存活點數，再量測 frames 幀；每幀比對兩者的存活點數與座標總和
+static bool bench(int points, int frames, struct bench_result *ring_result, struct bench_result *list_result)
+{
+    const uint64_t lifetime_ns = (uint64_t)points * BENCH_SAMPLE_NS;
+    struct path_buffer ring;
+    struct list_path list = {0};
+    if (!path_buffer_init(&ring, points + 64)) return false;
+
+    uint64_t next_sample = 0;
+    uint64_t now_ns = 0;
+    // 暖機：讓兩者都達到穩定的存活點數
+    for (; next_sample * BENCH_SAMPLE_NS <= lifetime_ns; ++next_sample) {
+        path_buffer_push(&ring, point_x(next_sample), point_y(next_sample), next_sample * BENCH_SAMPLE_NS);
+        list_push(&list, point_x(next_sample), point_y(next_sample), next_sample * BENCH_SAMPLE_NS);
+    }
+    now_ns = lifetime_ns;
+
+    double ring_update = 0.0, ring_traverse_s = 0.0, list_update = 0.0, list_traverse_s = 0.0;
+    bool identical = true;
+    volatile double sink = 0.0;
+    for (int f = 0; f < frames; ++f) {
+        now_ns += BENCH_FRAME_NS;
+        uint64_t first = next_sample;
+        uint64_t last = now_ns / BENCH_SAMPLE_NS;
+
+        double t0 = now_seconds();
+        for (uint64_t n = first; n <= last; ++n) {
+            path_buffer_push(&ring, point_x(n), point_y(n), n * BENCH_SAMPLE_NS);
+        }
+        path_buffer_expire(&ring, now_ns, lifetime_ns);
+        double t1 = now_seconds();
+        double ring_sum = ring_traverse(&ring);
+        double t2 = now_seconds();
+        for (uint64_t n = first; n <= last; ++n) {
+            list_push(&list, point_x(n), point_y(n), n * BENCH_SAMPLE_NS);
+        }
+        list_expire(&list, now_ns, lifetime_ns);
+        double t3 = now_seconds();
+        double list_sum = list_traverse(&list);
+        double t4 = now_seconds();
+
+        next_sample = last + 1;
+        ring_update += t1 - t0;
+        ring_traverse_s += t2 - t1;
+        list_update += t3 - t2;
+        list_traverse_s += t4 - t3;
+        identical = identical && ring.count == list.count && ring_sum == list_sum;
+        sink = sink + ring_sum + list_sum;
+    }
+    (void)sink;
+
+    ring_result->update_us = ring_update * 1e6 / frames;
+    ring_result->traverse_us = ring_traverse_s * 1e6 / frames;
+    list_result->update_us = list_update * 1e6 / frames;
+    list_result->traverse_us = list_traverse_s * 1e6 / frames;
+    path_buffer_free(&ring);
+    list_free(&list);
+    return identical;
+}
+
+int main(int argc, char **argv)
+{
+    static const int default_points[] = {1000, 10000, 100000};
+    int counts[64];
+    int count_n = 0;
+    int frames = 600;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (argv[i][0] != '-' && count_n < 64) {
+            counts[count_n++] = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [points ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (count_n == 0) {
+        count_n = (int)(sizeof(default_points) / sizeof(default_points[0]));
+        memcpy(counts, default_points, sizeof(default_points));
+    }
+    if (frames < 1) frames = 1;
+
+    bool mismatch = false;
+    printf("points,impl,update_us,traverse_us,frame_us,speedup,identical\n");
+    for (int i = 0; i < count_n; ++i) {
+        struct bench_result ring = {0}, list = {0};
+        bool identical = bench(counts[i], frames, &ring, &list);
+        mismatch = mismatch || !identical;
+        double list_frame = list.update_us + list.traverse_us;
+        double ring_frame = ring.update_us + ring.traverse_us;
+        printf("%d,list,%.3f,%.3f,%.3f,1.00,yes\n", counts[i], list.update_us, list.traverse_us, list_frame);
+        printf("%d,ring,%.3f,%.3f,%.3f,%.2f,%s\n", counts[i], ring.update_us, ring.traverse_us, ring_frame,
+               ring_frame > 0.0 ? list_frame / ring_frame : 0.0, identical ? "yes" : "NO");
+    }
+    return mismatch ? 2 : 0;
+}
@@ -0,0 +1,306 @@
+// sampler_bench：比較共用取樣器與每個來源各自取樣的成本（1 / 16 / 64 個來源）
+//
+// 以假的滑鼠來源後端（每次輪詢位置都會改變，因此每次輪詢都產生一個樣本）連結插件的
+// shared_sampler.c / input_sampler.c / monitor_cache.c，以 60 fps 模擬 N 個來源的 tick：
+//   per-source：插件原本的做法，每個來源各有一個後端、1 kHz 取樣執行緒與螢幕快取
+//   shared：所有來源透過 shared_sampler_get_frame 共用同一個取樣執行緒與本幀快照
+// 每個來源在 tick 中讀取本幀所有樣本並查詢最後一個樣本所在的螢幕。輸出每幀所有來源的 tick 耗時、
+// 整個行程（含取樣執行緒）的 CPU 使用率、取樣執行緒數與每秒的後端輪詢次數。
+// 用法：sampler_bench [--seconds S] [來源數 ...]（預設 1、16、64）
+
+#include "../shared_sampler.h"
+#include <obs-module.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define BENCH_RATE_HZ 1000
+#define BENCH_FRAME_NS 16666667ULL // 60 fps
+#define BENCH_WARMUP_NS 200000000ULL
+
+// 假後端：位置隨輪詢次數移動，所有後端共用輪詢計數
+static volatile long g_polls = 0;
+
+static void *fake_create(void)
+{
+    return bzalloc(sizeof(long));
+}
+
+static void fake_destroy(void *data)
+{
+    bfree(data);
+}
+
+static bool fake_get_position(void *data, int32_t *x, int32_t *y)
+{
+    long *own = data;
+    long n = ++*own;
+    os_atomic_inc_long(&g_polls);
+    *x = (int32_t)(n % 3840);
+    *y = (int32_t)((n / 3840) % 1080);
+    return true;
+}
+
+static int fake_enum_monitors(void *data, struct cursor_rect *rects, int max_count)
+{
+    (void)data;
+    static const struct cursor_rect monitors[2] = {{0, 0, 1920, 1080}, {1920, 0, 3840, 1080}};
+    int count = max_count < 2 ? max_count : 2;
+    memcpy(rects, monitors, sizeof(struct cursor_rect) * count);
+    return count;
+}
+
+static long fake_monitor_generation(void *data)
+{
+    (void)data;
+    return 1;
+}
+
+static const struct cursor_provider_ops fake_ops = {
+    .name = "fake",
+    .create = fake_create,
+    .destroy = fake_destroy,
+    .get_position = fake_get_position,
+    .enum_monitors = fake_enum_monitors,
+    .monitor_generation = fake_monitor_generation,
+};
+
+// 取代 cursor_provider.c：所有後端都是假後端
+bool cursor_provider_init(struct cursor_provider *provider)
+{
+    provider->ops = &fake_ops;
+    provider->data = provider->ops->create();
+    return provider->data != NULL;
+}
+
+void cursor_provider_free(struct cursor_provider *provider)
+{
+    if (provider->data) provider->ops->destroy(provider->data);
+    provider->data = NULL;
+}
+
+// 工具不連結 libobs：以下為取樣器用到的 libobs 函式的最小替代
+void *bmalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+void blog(int log_level, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[%d] ", log_level);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+uint64_t os_gettime_ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+bool os_sleepto_ns(uint64_t time_target)
+{
+    uint64_t now = os_gettime_ns();
+    if (time_target <= now) return false;
+#ifdef _WIN32
+    Sleep((DWORD)((time_target - now) / 1000000ULL));
+#else
+    uint64_t remaining = time_target - now;
+    struct timespec ts = {(time_t)(remaining / 1000000000ULL), (long)(remaining % 1000000000ULL)};
+    nanosleep(&ts, NULL);
+#endif
+    return true;
+}
+
+void os_set_thread_name(const char *name)
+{
+    (void)name;
+}
+
+static uint64_t g_frame_time = 0;
+
+uint64_t obs_get_video_frame_time(void)
+{
+    return g_frame_time;
+}
+
+// 整個行程（含所有執行緒）已使用的 CPU 時間
+static double process_cpu_seconds(void)
+{
+#ifdef _WIN32
+    FILETIME creation, exit_time, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit_time, &kernel, &user);
+    ULARGE_INTEGER k = {{kernel.dwLowDateTime, kernel.dwHighDateTime}};
+    ULARGE_INTEGER u = {{user.dwLowDateTime, user.dwHighDateTime}};
+    return (double)(k.QuadPart + u.QuadPart) / 1e7;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// 插件原本每個來源各自持有的取樣狀態
+struct source_sampler {
+    struct cursor_provider provider;
+    struct input_sampler *sampler;
+    struct cursor_sample *samples;
+    struct monitor_cache monitors;
+};
+
+// 來源在 tick 中對樣本做的事：走訪所有樣本，查詢最後一個樣本所在的螢幕
+static int64_t consume(const struct cursor_sample *samples, size_t count, struct monitor_cache *monitors)
+{
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) sum += samples[i].x + samples[i].y;
+    struct cursor_rect rect;
+    if (count > 0 && monitor_cache_resolve(monitors, COORDINATE_MONITOR_AUTO, samples[count - 1].x,
+                                           samples[count - 1].y, &rect)) {
+        sum += rect.left;
+    }
+    return sum;
+}
+
+struct bench_result {
+    double tick_us;         // 每幀所有來源的 tick 耗時
+    double cpu_percent;     // 行程 CPU 使用率（單核 = 100%）
+    double polls_per_second;
+    double samples_per_tick; // 每個來源每幀讀到的樣本數
+};
+
+static void run(int sources, bool shared, double seconds, struct bench_result *result)
+{
+    struct shared_sampler_client **clients = calloc((size_t)sources, sizeof(*clients));
+    struct source_sampler *own = calloc((size_t)sources, sizeof(*own));
+    for (int i = 0; i < sources; ++i) {
+        if (shared) {
+            clients[i] = shared_sampler_acquire(BENCH_RATE_HZ, false);
+            continue;
+        }
+        own[i].sampler = bzalloc(sizeof(struct input_sampler));
+        own[i].samples = bzalloc(sizeof(struct cursor_sample) * INPUT_SAMPLER_CAPACITY);
+        cursor_provider_init(&own[i].provider);
+        monitor_cache_init(&own[i].monitors);
+        input_sampler_start(own[i].sampler, &own[i].provider, BENCH_RATE_HZ);
+    }
+
+    uint64_t start = os_gettime_ns();
+    uint64_t measure_start = start + BENCH_WARMUP_NS;
+    uint64_t end = measure_start + (uint64_t)(seconds * 1e9);
+    uint64_t next_frame = start;
+    double cpu_start = 0.0, tick_seconds = 0.0;
+    long polls_start = 0;
+    uint64_t frames = 0, samples = 0;
+    volatile int64_t sink = 0;
+    bool measuring = false;
+
+    while (next_frame < end) {
+        next_frame += BENCH_FRAME_NS;
+        os_sleepto_ns(next_frame);
+        if (!measuring && next_frame >= measure_start) {
+            measuring = true;
+            cpu_start = process_cpu_seconds();
+            polls_start = os_atomic_load_long(&g_polls);
+        }
+        g_frame_time = next_frame;
+
+        uint64_t t0 = os_gettime_ns();
+        for (int i = 0; i < sources; ++i) {
+            size_t count;
+            if (shared) {
+                const struct sampler_frame *frame = shared_sampler_get_frame();
+                count = frame->count;
+                sink = sink + consume(frame->samples, count, shared_sampler_monitors());
+            } else {
+                count = input_sampler_drain(own[i].sampler, own[i].samples, INPUT_SAMPLER_CAPACITY);
+                monitor_cache_refresh(&own[i].monitors, &own[i].provider);
+                sink = sink + consume(own[i].samples, count, &own[i].monitors);
+            }
+            if (measuring) samples += count;
+        }
+        if (measuring) {
+            tick_seconds += (double)(os_gettime_ns() - t0) * 1e-9;
+            frames++;
+        }
+    }
+    (void)sink;
+
+    double wall = (double)(os_gettime_ns() - measure_start) * 1e-9;
+    result->tick_us = frames ? tick_seconds * 1e6 / (double)frames : 0.0;
+    result->cpu_percent = wall > 0.0 ? (process_cpu_seconds() - cpu_start) * 100.0 / wall : 0.0;
+    result->polls_per_second = wall > 0.0 ? (double)(os_atomic_load_long(&g_polls) - polls_start) / wall : 0.0;
+    result->samples_per_tick = frames ? (double)samples / (double)frames / (double)sources : 0.0;
+
+    for (int i = 0; i < sources; ++i) {
+        if (shared) {
+            shared_sampler_release(clients[i]);
+            continue;
+        }
+        input_sampler_stop(own[i].sampler);
+        cursor_provider_free(&own[i].provider);
+        bfree(own[i].sampler);
+        bfree(own[i].samples);
+    }
+    free(clients);
+    free(own);
+}
+
+int main(int argc, char **argv)
+{
+    static const int default_sources[] = {1, 16, 64};
+    int counts[64];
+    int count_n = 0;
+    double seconds = 2.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (argv[i][0] != '-' && count_n < 64) {
+            counts[count_n++] = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [sources ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (count_n == 0) {
+        count_n = (int)(sizeof(default_sources) / sizeof(default_sources[0]));
+        memcpy(counts, default_sources, sizeof(default_sources));
+    }
+
+    shared_sampler_init();
+    printf("sources,impl,sampler_threads,tick_us,cpu_percent,polls_per_second,samples_per_tick\n");
+    for (int i = 0; i < count_n; ++i) {
+        if (counts[i] < 1) continue;
+        for (int shared = 0; shared <= 1; ++shared) {
+            struct bench_result r;
+            run(counts[i], shared, seconds, &r);
+            printf("%d,%s,%d,%.2f,%.1f,%.0f,%.1f\n", counts[i], shared ? "shared" : "per-source",
+                   shared ? 1 : counts[i], r.tick_us, r.cpu_percent, r.polls_per_second, r.samples_per_tick);
+        }
+    }
+    shared_sampler_free();
+    return 0;
+}
@@ -0,0 +1,159 @@
+// x11_provider_test：在無頭 X 伺服器（Xvfb）中測試 X11 滑鼠來源後端
+//
+// 以插件的 cursor_provider_x11 建立後端，另外開一個連線用 XTest 把游標移到第一個螢幕內的幾個位置，確認：
+//   - 列舉到至少一個非空的螢幕範圍
+//   - get_position 在逾時前回報 XTest 移到的位置
+//   - 後端支援 XInput2 時，wait_motion 會因為移動事件而返回
+// 結束時把游標移回原位。沒有 DISPLAY、無法連線或伺服器沒有 XTest 時回傳 77（ctest 視為略過）。
+// 用法：x11_provider_test [--timeout-ms N]
+
+#include "../cursor_provider.h"
+#include <X11/Xlib.h>
+#include <X11/extensions/XTest.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TEST_SKIP 77
+#define TEST_POLL_NS 5000000L // 輪詢間隔 5 ms
+
+// 工具不連結 libobs：bmem 對應到 C 標準函式庫，記錄只輸出到 stderr
+void *bmalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+void blog(int log_level, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[%d] ", log_level);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static void sleep_poll(void)
+{
+    struct timespec ts = {0, TEST_POLL_NS};
+    nanosleep(&ts, NULL);
+}
+
+// 以 XTest 移動游標（與實體滑鼠相同經過輸入裝置，會產生 RawMotion）
+static void fake_move(Display *display, int x, int y)
+{
+    XTestFakeMotionEvent(display, -1, x, y, CurrentTime);
+    XSync(display, False);
+}
+
+// 輪詢後端直到回報目標位置或逾時
+static bool wait_position(struct cursor_provider *provider, int32_t x, int32_t y, int timeout_ms,
+                          int32_t *got_x, int32_t *got_y)
+{
+    *got_x = *got_y = -1;
+    for (long waited = 0; waited <= (long)timeout_ms * 1000000L; waited += TEST_POLL_NS) {
+        if (cursor_provider_get_position(provider, got_x, got_y) && *got_x == x && *got_y == y) return true;
+        sleep_poll();
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    int timeout_ms = 2000;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--timeout-ms") && i + 1 < argc) {
+            timeout_ms = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--timeout-ms N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const char *name = getenv("DISPLAY");
+    if (!name || !*name) {
+        printf("略過：沒有 DISPLAY（以 xvfb-run 執行）\n");
+        return TEST_SKIP;
+    }
+    Display *display = XOpenDisplay(NULL);
+    if (!display) {
+        printf("略過：無法連線到 X 伺服器 %s\n", name);
+        return TEST_SKIP;
+    }
+    int event_base, error_base, major, minor;
+    if (!XTestQueryExtension(display, &event_base, &error_base, &major, &minor)) {
+        printf("略過：X 伺服器沒有 XTest 擴充\n");
+        XCloseDisplay(display);
+        return TEST_SKIP;
+    }
+
+    struct cursor_provider provider;
+    if (!cursor_provider_init(&provider)) {
+        fprintf(stderr, "無法建立 X11 滑鼠來源後端\n");
+        XCloseDisplay(display);
+        return 2;
+    }
+
+    bool ok = true;
+    struct cursor_rect monitor;
+    int monitors = cursor_provider_enum_monitors(&provider, &monitor, 1);
+    if (monitors < 1 || monitor.right <= monitor.left || monitor.bottom <= monitor.top) {
+        fprintf(stderr, "沒有列舉到螢幕範圍\n");
+        cursor_provider_free(&provider);
+        XCloseDisplay(display);
+        return 2;
+    }
+    printf("backend,%s\nmonitor,%d,%d,%d,%d\n", provider.ops->name, monitor.left, monitor.top, monitor.right,
+           monitor.bottom);
+
+    // 記下原本的位置，結束時移回
+    Window root_ret, child_ret;
+    int start_x = 0, start_y = 0, win_x, win_y;
+    unsigned int mask;
+    XQueryPointer(display, DefaultRootWindow(display), &root_ret, &child_ret, &start_x, &start_y, &win_x, &win_y,
+                  &mask);
+
+    // 螢幕中央、四個角落（內縮一個像素）與一個不對稱的點
+    const int32_t w = monitor.right - monitor.left;
+    const int32_t h = monitor.bottom - monitor.top;
+    const int32_t targets[][2] = {
+        {monitor.left + w / 2, monitor.top + h / 2},
+        {monitor.left + 1, monitor.top + 1},
+        {monitor.right - 2, monitor.top + 1},
+        {monitor.right - 2, monitor.bottom - 2},
+        {monitor.left + 1, monitor.bottom - 2},
+        {monitor.left + w / 3, monitor.top + h / 5},
+    };
+    printf("target_x,target_y,reported_x,reported_y,result\n");
+    for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); ++i) {
+        int32_t got_x, got_y;
+        fake_move(display, targets[i][0], targets[i][1]);
+        bool hit = wait_position(&provider, targets[i][0], targets[i][1], timeout_ms, &got_x, &got_y);
+        printf("%d,%d,%d,%d,%s\n", targets[i][0], targets[i][1], got_x, got_y, hit ? "ok" : "FAIL");
+        ok = ok && hit;
+    }
+
+    // 事件驅動模式：先清掉已到達的事件，再移動一次，wait_motion 必須在逾時前返回
+    if (provider.ops->has_motion_events && provider.ops->has_motion_events(provider.data) &&
+        provider.ops->wait_motion) {
+        while (provider.ops->wait_motion(provider.data, 0)) {}
+        fake_move(display, targets[0][0], targets[0][1]);
+        bool woke = provider.ops->wait_motion(provider.data, (uint64_t)timeout_ms * 1000000ULL);
+        printf("wait_motion,%s\n", woke ? "ok" : "FAIL");
+        ok = ok && woke;
+    } else {
+        printf("wait_motion,skipped\n");
+    }
+
+    fake_move(display, start_x, start_y);
+    cursor_provider_free(&provider);
+    XCloseDisplay(display);
+    return ok ? 0 : 2;
+}